@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+
+#include "ambient_filter.h"
+
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_FILTER_EMA)
+
+// Average kept with 8 fractional bits, so small changes are not lost to rounding
+#define EMA_FRAC_BITS 8
+
+static int32_t ema_q8;
+static bool ema_primed = false;
+
+int32_t ambient_filter_sample(int32_t raw)
+{
+    int32_t raw_q8 = raw << EMA_FRAC_BITS;
+
+    if (!ema_primed)
+    {
+        ema_q8 = raw_q8;
+        ema_primed = true;
+    }
+    else
+    {
+        // alpha = 1 / 2^shift
+        ema_q8 += (raw_q8 - ema_q8) >> CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_EMA_SHIFT;
+    }
+
+    return (ema_q8 + (1 << (EMA_FRAC_BITS - 1))) >> EMA_FRAC_BITS;
+}
+
+#elif IS_ENABLED(CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_FILTER_MEDIAN)
+
+#define MEDIAN_SIZE CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_MEDIAN_SIZE
+
+BUILD_ASSERT(MEDIAN_SIZE % 2 == 1, "DONGLE_SCREEN_AMBIENT_LIGHT_MEDIAN_SIZE must be odd");
+
+static int32_t window[MEDIAN_SIZE];
+static size_t window_next;
+static bool window_primed = false;
+
+int32_t ambient_filter_sample(int32_t raw)
+{
+    int32_t sorted[MEDIAN_SIZE];
+
+    if (!window_primed)
+    {
+        // Fill with the first reading so the median is valid right away
+        for (size_t i = 0; i < MEDIAN_SIZE; i++)
+        {
+            window[i] = raw;
+        }
+        window_primed = true;
+    }
+
+    window[window_next] = raw;
+    window_next = (window_next + 1) % MEDIAN_SIZE;
+
+    // Insertion sort, the window is only a handful of entries
+    memcpy(sorted, window, sizeof(sorted));
+    for (size_t i = 1; i < MEDIAN_SIZE; i++)
+    {
+        int32_t v = sorted[i];
+        size_t j = i;
+
+        while (j > 0 && sorted[j - 1] > v)
+        {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = v;
+    }
+
+    return sorted[MEDIAN_SIZE / 2];
+}
+
+#else
+
+int32_t ambient_filter_sample(int32_t raw)
+{
+    return raw;
+}
+
+#endif
+
+static int64_t exceeded_since = -1;
+
+bool ambient_filter_hold(bool exceeds, int64_t now_ms)
+{
+    if (!exceeds)
+    {
+        exceeded_since = -1;
+        return false;
+    }
+
+    if (exceeded_since < 0)
+    {
+        exceeded_since = now_ms;
+    }
+
+    if (now_ms - exceeded_since < CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_HYSTERESIS_MS)
+    {
+        return false;
+    }
+
+    exceeded_since = -1;
+    return true;
+}
+
+bool ambient_filter_pending(void)
+{
+    return exceeded_since >= 0;
+}
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Feed one raw ambient light reading through the configured filter
+ *
+ * Depending on CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_FILTER_* this is a pass-through, an
+ * exponential moving average or the median of the last readings. The first reading
+ * initializes the filter, so the screen starts at the right level.
+ *
+ * @return The filtered reading
+ */
+int32_t ambient_filter_sample(int32_t raw);
+
+/**
+ * @brief Time-based hysteresis for brightness changes
+ *
+ * @param exceeds Whether the filtered brightness differs enough from the current one
+ * @param now_ms Current uptime
+ *
+ * @return true once @p exceeds held for CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_HYSTERESIS_MS
+ */
+bool ambient_filter_hold(bool exceeds, int64_t now_ms);
+
+/**
+ * @brief Whether a change is being held back by the hysteresis
+ */
+bool ambient_filter_pending(void);
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include "ambient_trace.h"
+#include "backlight.h"
+#include "widgets/brightness_status.h"
+
+#define MS_PER_HOUR (60 * 60 * 1000)
+#define AT(h, m, s) ((((h) * 60 + (m)) * 60 + (s)) * 1000)
+
+struct trace_point
+{
+    uint32_t t_ms;
+    uint16_t raw;
+};
+
+// Synthetic day at a desk next to a window, in raw sensor counts: dawn, a cloud at 10:20, a hand
+// over the sensor at 13:05, a lamp switched on at dusk and off at 22:00. Readings between the
+// points are interpolated linearly, two points close together make a sudden change.
+static const struct trace_point trace[] = {
+    {AT(0, 0, 0), 2},    {AT(5, 30, 0), 2},   {AT(6, 0, 0), 10},   {AT(7, 0, 0), 40},
+    {AT(8, 0, 0), 70},   {AT(9, 0, 0), 90},   {AT(10, 20, 0), 95}, {AT(10, 20, 5), 35},
+    {AT(10, 24, 0), 40}, {AT(10, 24, 5), 98}, {AT(12, 0, 0), 120}, {AT(13, 5, 0), 110},
+    {AT(13, 5, 1), 20},  {AT(13, 5, 3), 20},  {AT(13, 5, 4), 110}, {AT(15, 0, 0), 100},
+    {AT(17, 0, 0), 70},  {AT(18, 30, 0), 35}, {AT(18, 30, 1), 28}, {AT(22, 0, 0), 26},
+    {AT(22, 0, 1), 4},   {AT(24, 0, 0), 2},
+};
+
+#define TRACE_LENGTH_MS (trace[ARRAY_SIZE(trace) - 1].t_ms)
+
+static int64_t sim_now_ms;
+static size_t trace_idx;
+static uint32_t hour_start_pwm;
+static uint32_t hour_start_lvgl;
+
+int32_t ambient_trace_read(void)
+{
+    uint32_t t = sim_now_ms % TRACE_LENGTH_MS;
+
+    if (t < trace[trace_idx].t_ms)
+    {
+        trace_idx = 0; // The trace started over
+    }
+
+    // Time only moves forward, so the segment search resumes where it left off
+    while (trace_idx + 2 < ARRAY_SIZE(trace) && trace[trace_idx + 1].t_ms <= t)
+    {
+        trace_idx++;
+    }
+
+    const struct trace_point *a = &trace[trace_idx];
+    const struct trace_point *b = &trace[trace_idx + 1];
+
+    if (t >= b->t_ms)
+    {
+        return b->raw;
+    }
+
+    return a->raw + ((int32_t)(b->raw - a->raw) * (int32_t)(t - a->t_ms)) / (int32_t)(b->t_ms - a->t_ms);
+}
+
+k_timeout_t ambient_trace_advance(uint32_t sim_ms)
+{
+    int64_t prev_ms = sim_now_ms;
+
+    // The simulated clock keeps running across trace repetitions, so time based filters still work
+    sim_now_ms += sim_ms;
+
+    if (prev_ms / MS_PER_HOUR != sim_now_ms / MS_PER_HOUR)
+    {
+        uint32_t pwm = backlight_update_count();
+        uint32_t lvgl = zmk_widget_brightness_status_update_count();
+
+        LOG_INF("Trace hour %d: %u backlight updates, %u LVGL updates",
+                (int)((prev_ms % TRACE_LENGTH_MS) / MS_PER_HOUR), pwm - hour_start_pwm, lvgl - hour_start_lvgl);
+        hour_start_pwm = pwm;
+        hour_start_lvgl = lvgl;
+    }
+
+    if (prev_ms / TRACE_LENGTH_MS != sim_now_ms / TRACE_LENGTH_MS)
+    {
+        LOG_INF("Trace replay finished, starting over");
+    }
+
+    return K_MSEC(MAX(sim_ms / CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_TEST_SPEEDUP, 1));
+}
+
+int64_t ambient_trace_now_ms(void)
+{
+    return sim_now_ms;
+}
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <zephyr/kernel.h>
+
+/**
+ * @brief Raw ambient light reading of the replayed trace at the current simulated time
+ *
+ * Stands in for the sensor when CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_TEST is enabled. The trace
+ * is a fixed timeline, so every run produces the same readings and brightness changes.
+ */
+int32_t ambient_trace_read(void);
+
+/**
+ * @brief Advance the simulated clock
+ *
+ * Logs the backlight and LVGL update counts for every simulated hour that completed. The
+ * trace starts over once it ends.
+ *
+ * @param sim_ms Simulated time until the next reading
+ *
+ * @return Real time to wait, sim_ms divided by CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_TEST_SPEEDUP
+ */
+k_timeout_t ambient_trace_advance(uint32_t sim_ms);
+
+/**
+ * @brief Current simulated time in milliseconds since the replay started
+ */
+int64_t ambient_trace_now_ms(void);
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include "apds9960_als.h"
+
+// The Zephyr APDS9960 driver only supports threshold triggers on the proximity channel, so the
+// ALS interrupt is programmed here directly and the driver is disabled in this mode.
+#define APDS9960_NODE DT_INST(0, avago_apds9960)
+
+#define REG_ENABLE 0x80
+#define REG_ATIME 0x81
+#define REG_AILTL 0x84
+#define REG_PERS 0x8C
+#define REG_CONTROL 0x8F
+#define REG_ID 0x92
+#define REG_STATUS 0x93
+#define REG_CDATAL 0x94
+#define REG_AICLEAR 0xE7
+
+#define ENABLE_PON BIT(0)
+#define ENABLE_AEN BIT(1)
+#define ENABLE_AIEN BIT(4)
+
+#define STATUS_AVALID BIT(0)
+
+#define CONTROL_AGAIN_MASK 0x03
+#define CONTROL_AGAIN_4X 0x01
+
+#define ATIME_DEFAULT 219 // 37 cycles of 2.78 ms, APDS9960_ALS_CONVERSION_MS per conversion
+#define APERS_5_CYCLES 4  // APERS is a code, not a count: 4 fires after 5 out of window readings in a row
+
+static const struct i2c_dt_spec als_i2c = I2C_DT_SPEC_GET(APDS9960_NODE);
+static const struct gpio_dt_spec als_int = GPIO_DT_SPEC_GET(APDS9960_NODE, int_gpios);
+
+static struct gpio_callback als_int_cb;
+static apds9960_als_handler_t als_handler;
+
+static void als_int_isr(const struct device *port, struct gpio_callback *cb, gpio_port_pins_t pins)
+{
+    if (als_handler)
+    {
+        als_handler();
+    }
+}
+
+int apds9960_als_init(apds9960_als_handler_t handler)
+{
+    uint8_t id;
+    int rc;
+
+    if (!i2c_is_ready_dt(&als_i2c) || !gpio_is_ready_dt(&als_int))
+    {
+        LOG_ERR("APDS9960 bus or interrupt GPIO not ready");
+        return -ENODEV;
+    }
+
+    rc = i2c_reg_read_byte_dt(&als_i2c, REG_ID, &id);
+    if (rc < 0)
+    {
+        LOG_ERR("APDS9960 not responding (%d)", rc);
+        return rc;
+    }
+    LOG_DBG("APDS9960 ID 0x%02x", id);
+
+    als_handler = handler;
+
+    rc = i2c_reg_write_byte_dt(&als_i2c, REG_ENABLE, 0);
+    if (rc == 0)
+    {
+        rc = i2c_reg_write_byte_dt(&als_i2c, REG_ATIME, ATIME_DEFAULT);
+    }
+    if (rc == 0)
+    {
+        rc = i2c_reg_update_byte_dt(&als_i2c, REG_CONTROL, CONTROL_AGAIN_MASK, CONTROL_AGAIN_4X);
+    }
+    if (rc == 0)
+    {
+        rc = i2c_reg_write_byte_dt(&als_i2c, REG_PERS, APERS_5_CYCLES);
+    }
+    if (rc == 0)
+    {
+        // No interrupt until the caller seeds the window from the first valid reading
+        rc = apds9960_als_set_window(0, UINT16_MAX);
+    }
+    if (rc < 0)
+    {
+        LOG_ERR("APDS9960 ALS setup failed (%d)", rc);
+        return rc;
+    }
+
+    rc = gpio_pin_configure_dt(&als_int, GPIO_INPUT);
+    if (rc == 0)
+    {
+        gpio_init_callback(&als_int_cb, als_int_isr, BIT(als_int.pin));
+        rc = gpio_add_callback(als_int.port, &als_int_cb);
+    }
+    if (rc == 0)
+    {
+        rc = gpio_pin_interrupt_configure_dt(&als_int, GPIO_INT_EDGE_TO_ACTIVE);
+    }
+    if (rc < 0)
+    {
+        LOG_ERR("APDS9960 interrupt setup failed (%d)", rc);
+        return rc;
+    }
+
+    return i2c_reg_write_byte_dt(&als_i2c, REG_ENABLE, ENABLE_PON | ENABLE_AEN | ENABLE_AIEN);
+}
+
+int apds9960_als_read(uint16_t *clear)
+{
+    uint8_t status;
+    uint8_t buf[2];
+    int rc = i2c_reg_read_byte_dt(&als_i2c, REG_STATUS, &status);
+
+    if (rc == 0 && !(status & STATUS_AVALID))
+    {
+        return -EAGAIN;
+    }
+    if (rc == 0)
+    {
+        rc = i2c_burst_read_dt(&als_i2c, REG_CDATAL, buf, sizeof(buf));
+    }
+    if (rc == 0)
+    {
+        *clear = sys_get_le16(buf);
+    }
+    return rc;
+}
+
+int apds9960_als_set_window(uint16_t low, uint16_t high)
+{
+    uint8_t buf[4];
+
+    sys_put_le16(low, &buf[0]);
+    sys_put_le16(high, &buf[2]);
+
+    int rc = i2c_burst_write_dt(&als_i2c, REG_AILTL, buf, sizeof(buf));
+    if (rc < 0)
+    {
+        return rc;
+    }
+
+    // Any write to AICLEAR releases the interrupt line
+    return i2c_write_dt(&als_i2c, (uint8_t[]){REG_AICLEAR}, 1);
+}
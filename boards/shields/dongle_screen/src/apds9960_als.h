@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// Duration of one ALS conversion with the integration time set by apds9960_als_init()
+#define APDS9960_ALS_CONVERSION_MS 103
+
+/**
+ * @brief Called from the interrupt context when the ALS reading left the threshold window
+ */
+typedef void (*apds9960_als_handler_t)(void);
+
+/**
+ * @brief Put the APDS9960 into continuous ALS conversion with threshold interrupts
+ *
+ * Uses the same integration time and gain as the Zephyr driver defaults, so raw readings keep
+ * the scale of CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_MIN/MAX_RAW_VALUE. No interrupt fires until
+ * apds9960_als_set_window() is called with a window around a first reading.
+ *
+ * @return 0 on success, negative errno otherwise
+ */
+int apds9960_als_init(apds9960_als_handler_t handler);
+
+/**
+ * @brief Read the latest clear channel value, same as SENSOR_CHAN_LIGHT of the Zephyr driver
+ *
+ * @return 0 on success, -EAGAIN if no conversion completed since the ALS was enabled or last
+ *         read (retry after APDS9960_ALS_CONVERSION_MS), other negative errno on bus errors
+ */
+int apds9960_als_read(uint16_t *clear);
+
+/**
+ * @brief Arm the ALS interrupt for readings outside of [low, high] and clear a pending one
+ */
+int apds9960_als_set_window(uint16_t low, uint16_t high);
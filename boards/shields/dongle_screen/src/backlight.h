@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Backlight backend
+ *
+ * A fade is handed to the backend as a precomputed sequence of brightness levels, so a
+ * backend with sequence playback in hardware can run it without waking the CPU per step.
+ * backlight_sw.c implements it in software on the brightness work queue, backlight_nrf_pwm.c
+ * with the sequence playback of the nRF52 PWM peripheral.
+ */
+
+#define BACKLIGHT_SEQUENCE_MAX_LEN 33
+
+/**
+ * @brief Set the backlight level immediately, stopping a running sequence
+ */
+int backlight_set(uint8_t level);
+
+/**
+ * @brief Play a sequence of brightness levels, one level every @p step_us
+ *
+ * The levels are copied, a running sequence is replaced. The last level stays applied.
+ *
+ * @return 0 on success, -EINVAL if the sequence is empty or longer than BACKLIGHT_SEQUENCE_MAX_LEN
+ */
+int backlight_play(const uint8_t *levels, size_t count, uint32_t step_us);
+
+/**
+ * @brief Level currently applied to the hardware, also while a sequence is playing
+ */
+uint8_t backlight_get(void);
+
+/**
+ * @brief Whether a sequence is still playing
+ */
+bool backlight_busy(void);
+
+/**
+ * @brief Number of duty cycle writes by the CPU since boot, a sequence played by the hardware counts once
+ */
+uint32_t backlight_update_count(void);
@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <zephyr/sys/util_macro.h>
+
+// Logical brightness (0-100) to PWM duty cycle in 1/10000, generated at compile time.
+// The perceptual curve follows CIE 1976 L* (cubic above L* = 8). Level 1 starts at L* = 9, which
+// is 1 % duty like level 1 of the linear curve, so the darkest setting stays as visible as before.
+// The levels in between are darker than linear, e.g. level 10 is 2.3 % instead of 10 %.
+#define DUTY_MAX 10000
+#define LSTAR_MIN_X10 90
+#define LSTAR_X10(l) (LSTAR_MIN_X10 + ((l) - 1) * (1000 - LSTAR_MIN_X10) / 99)
+#define CIE_DUTY(l)                                                                                \
+    ((l) == 0 ? 0                                                                                  \
+              : ((uint64_t)(LSTAR_X10(l) + 160) * (LSTAR_X10(l) + 160) * (LSTAR_X10(l) + 160) *     \
+                 DUTY_MAX) /                                                                       \
+                    ((uint64_t)1160 * 1160 * 1160))
+
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_BRIGHTNESS_PERCEPTUAL)
+#define DUTY_ENTRY(l, _) CIE_DUTY(l)
+#else
+#define DUTY_ENTRY(l, _) ((l) * (DUTY_MAX / 100))
+#endif
+
+// Only included by the backlight backend in use
+static const uint16_t brightness_to_duty[101] = {LISTIFY(101, DUTY_ENTRY, (, ))};
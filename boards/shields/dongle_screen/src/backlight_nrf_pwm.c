@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/pwm.h>
+#include <zephyr/logging/log.h>
+#include <hal/nrf_pwm.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include "backlight.h"
+#include "backlight_duty.h"
+
+/*
+ * Hardware playback on the nRF52 PWM peripheral: the whole sequence is written to RAM once
+ * and the PWM steps through it with EasyDMA, holding every value for a number of PWM periods
+ * (SEQ[0].REFRESH). The last value stays applied when the sequence ends.
+ *
+ * The Zephyr PWM driver still owns the peripheral: it sets up the clock, the counter top for
+ * the period and the pins. Only the sequence registers are taken over.
+ */
+
+#define BACKLIGHT_NODE DT_NODELABEL(disp_bl)
+
+static const struct pwm_dt_spec backlight_pwm = PWM_DT_SPEC_GET(BACKLIGHT_NODE);
+static NRF_PWM_Type *const pwm_reg = (NRF_PWM_Type *)DT_REG_ADDR(DT_PWMS_CTLR(BACKLIGHT_NODE));
+
+// Bit 15 of a sequence value selects the polarity of the pulse
+#define SEQ_POLARITY_RISING BIT(15)
+
+// Two buffers, so a running sequence is never overwritten while EasyDMA reads it. A buffer is
+// only free again once the sequence after it has started, see wait_for_sequence_start().
+static nrf_pwm_values_individual_t hw_seq[2][BACKLIGHT_SEQUENCE_MAX_LEN];
+
+// What is playing, to tell the current level without reading the peripheral
+struct sequence_state
+{
+    uint8_t levels[BACKLIGHT_SEQUENCE_MAX_LEN];
+    size_t count;
+    uint32_t step_us;
+    int64_t start_ticks;
+    uint8_t buffer;
+};
+
+static struct sequence_state seq;
+static struct k_spinlock seq_lock;
+static uint32_t pwm_updates;
+
+// Index of the level applied now, called with seq_lock held
+static size_t current_index(void)
+{
+    if (seq.count <= 1)
+    {
+        return 0;
+    }
+
+    uint64_t elapsed_us = k_ticks_to_us_floor64(k_uptime_ticks() - seq.start_ticks);
+
+    return MIN(elapsed_us / seq.step_us, seq.count - 1);
+}
+
+/*
+ * SEQSTART0 only takes effect at the end of the running PWM period, until then EasyDMA keeps
+ * reading the buffer of the sequence before. Wait for SEQSTARTED0 of the previous play before
+ * that buffer is written again. Plays are far more than a period apart, so this only spins
+ * when two of them come within one period. Called with seq_lock held.
+ */
+static void wait_for_sequence_start(uint32_t period_us)
+{
+    for (uint32_t waited_us = 0;
+         !nrf_pwm_event_check(pwm_reg, NRF_PWM_EVENT_SEQSTARTED0) && waited_us < 2 * period_us;
+         waited_us++)
+    {
+        k_busy_wait(1);
+    }
+}
+
+int backlight_play(const uint8_t *levels, size_t count, uint32_t step_us)
+{
+    if (count == 0 || count > BACKLIGHT_SEQUENCE_MAX_LEN)
+    {
+        return -EINVAL;
+    }
+
+    if (!pwm_is_ready_dt(&backlight_pwm))
+    {
+        LOG_ERR("Backlight PWM not ready!");
+        return -ENODEV;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&seq_lock);
+
+    // Every value is played once plus REFRESH more PWM periods
+    uint32_t period_us = MAX(backlight_pwm.period / NSEC_PER_USEC, 1);
+    uint32_t refresh = CLAMP(step_us / period_us, 1, PWM_SEQ_REFRESH_CNT_Msk + 1) - 1;
+    uint16_t top = pwm_reg->COUNTERTOP;
+    uint16_t polarity = (backlight_pwm.flags & PWM_POLARITY_INVERTED) ? 0 : SEQ_POLARITY_RISING;
+
+    if (seq.count > 0)
+    {
+        wait_for_sequence_start(period_us);
+    }
+
+    seq.buffer ^= 1;
+    nrf_pwm_values_individual_t *values = hw_seq[seq.buffer];
+
+    memset(values, 0, count * sizeof(*values));
+    for (size_t i = 0; i < count; i++)
+    {
+        uint16_t pulse = (uint32_t)top * brightness_to_duty[MIN(levels[i], 100)] / DUTY_MAX;
+
+        ((uint16_t *)&values[i])[backlight_pwm.channel] = pulse | polarity;
+    }
+
+    nrf_pwm_shorts_set(pwm_reg, 0);
+    nrf_pwm_loop_set(pwm_reg, 0);
+    nrf_pwm_seq_ptr_set(pwm_reg, 0, (const uint16_t *)values);
+    nrf_pwm_seq_cnt_set(pwm_reg, 0, count * NRF_PWM_CHANNEL_COUNT);
+    nrf_pwm_seq_refresh_set(pwm_reg, 0, refresh);
+    nrf_pwm_seq_end_delay_set(pwm_reg, 0, 0);
+    // Restarts a running sequence with the new one at the next PWM period
+    nrf_pwm_event_clear(pwm_reg, NRF_PWM_EVENT_SEQSTARTED0);
+    nrf_pwm_task_trigger(pwm_reg, NRF_PWM_TASK_SEQSTART0);
+
+    memcpy(seq.levels, levels, count);
+    seq.count = count;
+    seq.step_us = (refresh + 1) * period_us;
+    seq.start_ticks = k_uptime_ticks();
+    pwm_updates++;
+
+    k_spin_unlock(&seq_lock, key);
+
+    LOG_DBG("Backlight sequence of %zu levels, %u us each, ends at %d", count, seq.step_us, levels[count - 1]);
+    return 0;
+}
+
+uint8_t backlight_get(void)
+{
+    k_spinlock_key_t key = k_spin_lock(&seq_lock);
+    uint8_t level = seq.count ? seq.levels[current_index()] : 0; // Nothing played yet, the backlight is off
+    k_spin_unlock(&seq_lock, key);
+
+    return level;
+}
+
+bool backlight_busy(void)
+{
+    k_spinlock_key_t key = k_spin_lock(&seq_lock);
+    bool busy = seq.count > 1 && current_index() < seq.count - 1;
+    k_spin_unlock(&seq_lock, key);
+
+    return busy;
+}
+
+int backlight_set(uint8_t level)
+{
+    return backlight_play(&level, 1, 0);
+}
+
+uint32_t backlight_update_count(void)
+{
+    return pwm_updates;
+}
+
+static int backlight_nrf_pwm_init(void)
+{
+    if (!pwm_is_ready_dt(&backlight_pwm))
+    {
+        LOG_ERR("Backlight PWM not ready!");
+        return -ENODEV;
+    }
+
+    // A pulse between 0 and the full period makes the driver enable the peripheral and connect
+    // the pin instead of driving it as a constant GPIO. The first sequence replaces it.
+    return pwm_set_pulse_dt(&backlight_pwm, backlight_pwm.period / 100);
+}
+
+// Before init_fixed_brightness() plays the first sequence
+SYS_INIT(backlight_nrf_pwm_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY - 1);
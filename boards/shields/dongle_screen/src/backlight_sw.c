@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/pwm.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include "backlight.h"
+#include "backlight_duty.h"
+#include "brightness.h"
+
+static const struct pwm_dt_spec backlight_pwm = PWM_DT_SPEC_GET(DT_NODELABEL(disp_bl));
+
+// Software playback, one work item run per sequence step
+struct sequence_state
+{
+    uint8_t levels[BACKLIGHT_SEQUENCE_MAX_LEN];
+    size_t count;
+    size_t next;
+    k_timeout_t step_delay;
+    uint8_t last_applied; // Used to prevent redundant LED updates
+};
+
+static struct sequence_state seq = {.last_applied = 255};
+static struct k_spinlock seq_lock;
+static uint32_t pwm_updates;
+
+static void apply_brightness(uint8_t value)
+{
+    if (value == seq.last_applied)
+    {
+        return;
+    }
+
+    if (!pwm_is_ready_dt(&backlight_pwm))
+    {
+        LOG_ERR("Backlight PWM not ready!");
+        return;
+    }
+
+    uint32_t duty = brightness_to_duty[MIN(value, 100)];
+    pwm_set_pulse_dt(&backlight_pwm, (uint64_t)backlight_pwm.period * duty / DUTY_MAX);
+
+    // Only written here on the work queue, read from other threads by backlight_get()
+    k_spinlock_key_t key = k_spin_lock(&seq_lock);
+    seq.last_applied = value;
+    k_spin_unlock(&seq_lock, key);
+
+    pwm_updates++;
+    LOG_DBG("Screen brightness set to %d", value);
+}
+
+static void sequence_work_cb(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(sequence_work, sequence_work_cb);
+
+static void sequence_work_cb(struct k_work *work)
+{
+    k_spinlock_key_t key = k_spin_lock(&seq_lock);
+
+    if (seq.next >= seq.count)
+    {
+        k_spin_unlock(&seq_lock, key);
+        return;
+    }
+
+    uint8_t level = seq.levels[seq.next++];
+    bool done = seq.next >= seq.count;
+
+    k_spin_unlock(&seq_lock, key);
+
+    apply_brightness(level);
+
+    if (done)
+    {
+        LOG_INF("Screen brightness set to %d", level);
+        return;
+    }
+
+    k_work_schedule_for_queue(&brightness_work_q, &sequence_work, seq.step_delay);
+}
+
+int backlight_play(const uint8_t *levels, size_t count, uint32_t step_us)
+{
+    if (count == 0 || count > BACKLIGHT_SEQUENCE_MAX_LEN)
+    {
+        return -EINVAL;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&seq_lock);
+
+    memcpy(seq.levels, levels, count);
+    seq.count = count;
+    seq.next = 0;
+    seq.step_delay = K_USEC(step_us);
+
+    k_spin_unlock(&seq_lock, key);
+
+    k_work_reschedule_for_queue(&brightness_work_q, &sequence_work, K_NO_WAIT);
+    return 0;
+}
+
+uint8_t backlight_get(void)
+{
+    k_spinlock_key_t key = k_spin_lock(&seq_lock);
+    uint8_t level = seq.last_applied;
+    k_spin_unlock(&seq_lock, key);
+
+    return level == 255 ? 0 : level; // Nothing applied yet, the backlight is off
+}
+
+bool backlight_busy(void)
+{
+    k_spinlock_key_t key = k_spin_lock(&seq_lock);
+    bool busy = seq.next < seq.count;
+    k_spin_unlock(&seq_lock, key);
+
+    return busy;
+}
+
+int backlight_set(uint8_t level)
+{
+    return backlight_play(&level, 1, 0);
+}
+
+uint32_t backlight_update_count(void)
+{
+    return pwm_updates;
+}
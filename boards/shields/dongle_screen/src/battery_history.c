@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+
+#include "battery_history.h"
+#include "widgets/battery_status.h"
+
+#define HISTORY_SIZE CONFIG_DONGLE_SCREEN_BATTERY_HISTORY_SIZE
+
+// Fewest samples a drain rate is estimated from
+#define HISTORY_MIN_SAMPLES 3
+
+// A rise this far above the lowest level since the history started means the battery charged.
+// Smaller rises are reporting jitter and stay in the fit.
+#define HISTORY_CHARGE_RISE 3
+
+#define MS_PER_MIN (60 * 1000)
+
+// Sample times are minutes since the history started, which covers about 45 days
+struct battery_sample
+{
+    uint16_t t_min;
+    uint8_t level;
+};
+
+struct battery_history
+{
+    struct battery_sample samples[HISTORY_SIZE];
+    uint8_t next;
+    uint8_t count;
+    uint8_t min_level;
+    int64_t start_min;
+
+    // Running sums over the samples in the ring, x is the sample time and y the level
+    int64_t sum_x;
+    int64_t sum_y;
+    int64_t sum_xx;
+    int64_t sum_xy;
+};
+
+static struct battery_history histories[BATTERY_SOURCE_COUNT];
+
+static void history_reset(struct battery_history *h, int64_t now_min)
+{
+    *h = (struct battery_history){
+        .start_min = now_min,
+    };
+}
+
+static void history_sums_update(struct battery_history *h, const struct battery_sample *s, int sign)
+{
+    int64_t x = s->t_min;
+    int64_t y = s->level;
+
+    h->sum_x += sign * x;
+    h->sum_y += sign * y;
+    h->sum_xx += sign * x * x;
+    h->sum_xy += sign * x * y;
+}
+
+static const struct battery_sample *history_last(const struct battery_history *h)
+{
+    return &h->samples[(h->next + HISTORY_SIZE - 1) % HISTORY_SIZE];
+}
+
+void battery_history_add(uint8_t source, uint8_t level, bool charging, int64_t now_ms)
+{
+    if (source >= BATTERY_SOURCE_COUNT)
+    {
+        return;
+    }
+
+    struct battery_history *h = &histories[source];
+    int64_t now_min = now_ms / MS_PER_MIN;
+
+    if (charging)
+    {
+        history_reset(h, now_min); // Nothing drains while on USB power
+        return;
+    }
+
+    if (level == 0)
+    {
+        return; // What a disconnected peripheral reports, not a reading
+    }
+
+    if (h->count > 0)
+    {
+        if (level == history_last(h)->level)
+        {
+            return; // Only changes carry information about the drain rate
+        }
+
+        if (level >= h->min_level + HISTORY_CHARGE_RISE || now_min - h->start_min > UINT16_MAX)
+        {
+            history_reset(h, now_min);
+        }
+    }
+
+    if (h->count == 0)
+    {
+        h->start_min = now_min;
+        h->min_level = level;
+    }
+    else
+    {
+        h->min_level = MIN(h->min_level, level);
+    }
+
+    struct battery_sample *slot = &h->samples[h->next];
+
+    if (h->count == HISTORY_SIZE)
+    {
+        history_sums_update(h, slot, -1); // The oldest sample drops out of the window
+    }
+    else
+    {
+        h->count++;
+    }
+
+    *slot = (struct battery_sample){
+        .t_min = now_min - h->start_min,
+        .level = level,
+    };
+    history_sums_update(h, slot, 1);
+    h->next = (h->next + 1) % HISTORY_SIZE;
+}
+
+int32_t battery_history_minutes_remaining(uint8_t source, int64_t now_ms)
+{
+    if (source >= BATTERY_SOURCE_COUNT)
+    {
+        return -1;
+    }
+
+    const struct battery_history *h = &histories[source];
+
+    if (h->count < HISTORY_MIN_SAMPLES)
+    {
+        return -1;
+    }
+
+    // Least squares slope = num / den in percent per minute, exact in integers
+    int64_t n = h->count;
+    int64_t num = n * h->sum_xy - h->sum_x * h->sum_y;
+    int64_t den = n * h->sum_xx - h->sum_x * h->sum_x;
+
+    if (num >= 0 || den <= 0)
+    {
+        return -1;
+    }
+
+    // The fit gives the time left at the last sample, the level has been draining since
+    const struct battery_sample *last = history_last(h);
+    int64_t elapsed_min = now_ms / MS_PER_MIN - (h->start_min + last->t_min);
+    int64_t remaining = (int64_t)last->level * den / -num - MAX(elapsed_min, 0);
+
+    return (int32_t)CLAMP(remaining, 0, INT32_MAX);
+}
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Record the battery level of a source
+ *
+ * Keeps the last CONFIG_DONGLE_SCREEN_BATTERY_HISTORY_SIZE levels of every source together
+ * with the running sums of a linear regression over them, so adding a sample is O(1). USB power
+ * or a level at least 3% above the lowest one recorded means the battery charged, which starts
+ * a new history. Level 0 is what a disconnected peripheral reports and isn't recorded.
+ *
+ * @param source Battery source, 0 is the dongle if it reports its own battery
+ * @param level State of charge in percent
+ * @param charging The source runs on USB power
+ * @param now_ms Current uptime
+ */
+void battery_history_add(uint8_t source, uint8_t level, bool charging, int64_t now_ms);
+
+/**
+ * @brief Estimated time until the battery of a source is empty
+ *
+ * Extrapolates the drain rate fitted over the recorded levels down to 0%, less the time that
+ * passed since the last recorded level.
+ *
+ * @param now_ms Current uptime
+ * @return Minutes remaining, or -1 while there are too few samples or the level isn't falling
+ */
+int32_t battery_history_minutes_remaining(uint8_t source, int64_t now_ms);
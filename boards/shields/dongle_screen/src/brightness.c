@@ -1,21 +1,20 @@
 #include <zephyr/kernel.h>
 #include <zephyr/device.h>
 #include <zephyr/drivers/sensor.h>
-#include <zephyr/drivers/led.h>
+#include <zephyr/settings/settings.h>
 #include <zephyr/logging/log.h>
 #include <zmk/event_manager.h>
 #include <zmk/events/keycode_state_changed.h>
 #include <zmk/events/layer_state_changed.h>
-#include <math.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "widgets/brightness_status.h"
-#include "custom_status_screen.h"
-
-int random0to100()
-{
-    return rand() % 101; // 0 to 100
-}
+#include "brightness_fade.h"
+#include "brightness.h"
+#include "apds9960_als.h"
+#include "ambient_filter.h"
+#include "ambient_trace.h"
 
 LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 
@@ -49,8 +48,10 @@ LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 #define SCREEN_IDLE_TIMEOUT_MS (CONFIG_DONGLE_SCREEN_IDLE_TIMEOUT_S * 1000)
 #define BRIGHTNESS_CHANGE_THRESHOLD 5
 
-static const struct device *pwm_leds_dev = DEVICE_DT_GET_ONE(pwm_leds);
-#define DISP_BL DT_NODE_CHILD_IDX(DT_NODELABEL(disp_bl))
+// All brightness handling (key events, idle timeout, ambient light and fade steps) runs on this
+// work queue, which replaces the former fade, idle and ambient light threads.
+static K_THREAD_STACK_DEFINE(brightness_work_q_stack, CONFIG_DONGLE_SCREEN_BRIGHTNESS_WORK_QUEUE_STACK_SIZE);
+struct k_work_q brightness_work_q;
 
 static int64_t last_activity = 0;
 static uint8_t max_brightness = CONFIG_DONGLE_SCREEN_MAX_BRIGHTNESS;
@@ -89,12 +90,6 @@ static uint8_t clamp_brightness(int8_t value)
     return value;
 }
 
-static void apply_brightness(uint8_t value)
-{
-    led_set_brightness(pwm_leds_dev, DISP_BL, value);
-    LOG_INF("Screen brightness set to %d", value);
-}
-
 static int8_t calculate_safe_modifier_change(uint8_t base_brightness, int8_t current_modifier, int8_t desired_change)
 {
     int16_t current_effective = base_brightness + current_modifier;
@@ -202,112 +197,120 @@ static bool should_screen_turn_on(uint8_t base_brightness, int8_t modifier)
     return (base_brightness + modifier) > min_brightness;
 }
 
-// Threaded fade logic
-// Contains starting and target brightness levels to be animated
-struct fade_request_t
-{
-    uint8_t from; // Starting brightness level
-    uint8_t to;   // Target brightness level
-};
-
-#define FADE_QUEUE_SIZE 4
+// --- Persistence ---
 
-// Message queue used to send fade requests to the fade handler thread.
-// It holds up to 4 fade_request_t elements and ensures brightness updates are handled sequentially.
-K_MSGQ_DEFINE(fade_msgq, sizeof(struct fade_request_t), FADE_QUEUE_SIZE, 4);
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_BRIGHTNESS_PERSIST)
 
-// Cubic ease-in-out function to smooth the interpolation curve.
-// Provides a natural "S-curve" animation effect: starts slow, accelerates, then slows again.
-// Helps avoid abrupt changes in perceived brightness.
-static float ease_in_out(float t)
+struct brightness_state
 {
-    if (t < 0.5f)
-        return 4.0f * t * t * t;
-    float f = -2.0f * t + 2.0f;
-    return 1.0f - (f * f * f) / 2.0f;
-}
+    int8_t brightness;
+    int8_t modifier;
+};
 
-// Dedicated thread responsible for handling all fade animations.
-// Receives fade requests from the queue and applies brightness changes over time using easing.
-void fade_thread(void)
+static struct brightness_state saved_state;
+static bool saved_state_loaded = false;
+
+static int brightness_settings_set(const char *name, size_t len, settings_read_cb read_cb, void *cb_arg)
 {
-    struct fade_request_t req;
+    const char *next;
 
-    while (1)
+    if (settings_name_steq(name, "state", &next) && !next)
     {
-        // Wait indefinitely for the next fade request to arrive in the queue
-        if (k_msgq_get(&fade_msgq, &req, K_FOREVER) == 0)
+        if (len != sizeof(saved_state))
         {
+            return -EINVAL;
+        }
 
-            // Skip animation entirely if brightness difference is too small
-            if (req.from == req.to || abs(req.to - req.from) <= 1)
-            {
-                apply_brightness(req.to);
-                continue;
-            }
+        int rc = read_cb(cb_arg, &saved_state, sizeof(saved_state));
+        if (rc >= 0)
+        {
+            saved_state_loaded = true;
+            return 0;
+        }
+        return rc;
+    }
 
-            // Calculate brightness difference and use it to determine number of steps
-            int diff = abs(req.to - req.from);
-            int steps = CLAMP(diff * 2, 6, 32); // More steps for smoother fades over large differences
+    return -ENOENT;
+}
 
-            // Set total animation time: scale with difference but clamp between 500ms and 1000ms
-            int total_duration_ms = CLAMP(diff * 20, 500, 1000); // 20ms per level as baseline
-            int delay_us = (total_duration_ms * 1000) / steps;   // Delay between steps in microseconds
+SETTINGS_STATIC_HANDLER_DEFINE(dongle_screen, "dongle_screen", NULL, brightness_settings_set, NULL, NULL);
 
-            uint8_t last_applied = 255; // Used to prevent redundant LED updates to save performance
+// Only scheduled by the brightness keys. With the ambient light sensor the brightness follows the
+// room, so the record keeps the brightness it already had, or the default, and only the modifier
+// the user picked changes. A room reading would make every later save differ from the record.
+static void brightness_save_work_cb(struct k_work *work)
+{
+    struct brightness_state state = {
+        .brightness = current_brightness,
+        .modifier = brightness_modifier,
+    };
 
-            // Interpolate brightness across 'steps' frames using easing
-            for (int i = 0; i <= steps; i++)
-            {
-                float t = (float)i / steps;                                  // Normalized time in [0, 1]
-                float eased = ease_in_out(t);                                // Eased time for smoother progression
-                float interpolated = req.from + (req.to - req.from) * eased; // Interpolated value
-                uint8_t brightness = (uint8_t)(interpolated + 0.5f);         // Rounded to nearest integer
-
-                // Only send update if brightness actually changed
-                if (brightness != last_applied)
-                {
-                    apply_brightness(brightness);
-                    last_applied = brightness;
-                }
-
-                k_usleep(delay_us); // Sleep before next step to pace the fade
-            }
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT)
+    state.brightness = saved_state_loaded ? saved_state.brightness : CONFIG_DONGLE_SCREEN_DEFAULT_BRIGHTNESS;
+#endif
 
-            // safeguard to ensure the target value is set at the end
-            if (last_applied != req.to)
-            {
-                apply_brightness(req.to);
-            }
-        }
+    // Adjusting back and forth within the debounce time ends up where it started, nothing to write
+    if (saved_state_loaded && memcmp(&state, &saved_state, sizeof(state)) == 0)
+    {
+        return;
     }
+
+    int rc = settings_save_one("dongle_screen/state", &state, sizeof(state));
+    if (rc < 0)
+    {
+        LOG_ERR("Failed to save brightness state (%d)", rc);
+        return;
+    }
+
+    saved_state = state;
+    saved_state_loaded = true;
+    LOG_DBG("Saved brightness %d, modifier %d", state.brightness, state.modifier);
 }
 
-// Launch the fade thread with 768 bytes of stack, medium priority (6)
-// 512 was too small for logging, math (float, int), small loop, few stack-local variables
-// 768 is just a guess, optimization is possible, probably
-K_THREAD_DEFINE(fade_tid, 768, fade_thread, NULL, NULL, NULL, 6, 0, 0);
+static K_WORK_DELAYABLE_DEFINE(brightness_save_work, brightness_save_work_cb);
 
-// Function to submit a brightness fade request
-// Ensures that only the most recent fade request is applied by purging the queue first for changes in between animations
-static void fade_to_brightness(uint8_t from, uint8_t to)
+// Every change restarts the debounce, so a burst of adjustments results in a single write
+static void brightness_schedule_save(void)
 {
-    struct fade_request_t req = {.from = from, .to = to};
-    k_msgq_purge(&fade_msgq);                // Clear any pending fades to avoid outdated transitions
-    k_msgq_put(&fade_msgq, &req, K_NO_WAIT); // Submit the new fade request without blocking
+    k_work_reschedule_for_queue(&brightness_work_q, &brightness_save_work,
+                                K_MSEC(CONFIG_ZMK_SETTINGS_SAVE_DEBOUNCE));
 }
 
+static void brightness_load_state(void)
+{
+    settings_subsys_init();
+    settings_load_subtree("dongle_screen");
+
+    if (!saved_state_loaded)
+    {
+        return;
+    }
+
+    // The limits may have changed since the state was saved
+    current_brightness = clamp_brightness(saved_state.brightness);
+    brightness_modifier = CLAMP(saved_state.modifier, min_brightness - max_brightness, max_brightness - min_brightness);
+    LOG_INF("Restored brightness %d, modifier %d", current_brightness, brightness_modifier);
+}
+
+#else
+
+static void brightness_schedule_save(void) {}
+
+#endif // CONFIG_DONGLE_SCREEN_BRIGHTNESS_PERSIST
+
 void set_screen_brightness(uint8_t value, bool ambient)
 {
     struct brightness_result result = calculate_brightness_with_bounds(value, brightness_modifier, ambient);
 
-    uint8_t current_effective = clamp_brightness(current_brightness + brightness_modifier);
-
-    fade_to_brightness(current_effective, result.effective_brightness);
+    brightness_fade_to(result.effective_brightness);
     current_brightness = result.adjusted_brightness;
-    zmk_widget_update_brightness_status(&brightness_status_widget, result.effective_brightness);
+    zmk_widget_brightness_status_post(result.effective_brightness);
 }
 
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_SAMPLING_ADAPTIVE)
+static void ambient_light_wake(void);
+#endif
+
 #if CONFIG_DONGLE_SCREEN_IDLE_TIMEOUT_S > 0 || CONFIG_DONGLE_SCREEN_BRIGHTNESS_KEYBOARD_CONTROL
 // --- Brightness logic ---
 static bool screen_on = true;
@@ -325,14 +328,17 @@ static void screen_set_on(bool on)
             LOG_DBG("SCREEN TURN ON: Adjusted brightness to ensure screen can turn on: %d", current_brightness);
         }
 
-        fade_to_brightness(0, clamp_brightness(current_brightness + brightness_modifier));
+        brightness_fade_to(clamp_brightness(current_brightness + brightness_modifier));
         screen_on = true;
         off_through_modifier = false; // Reset the flag, because the screen is turned on again
         LOG_INF("Screen on (smooth)");
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_SAMPLING_ADAPTIVE)
+        ambient_light_wake();
+#endif
     }
     else if (!on && screen_on)
     {
-        fade_to_brightness(clamp_brightness(current_brightness + brightness_modifier), 0);
+        brightness_fade_to(0);
         screen_on = false;
         LOG_INF("Screen off (smooth)");
     }
@@ -344,61 +350,27 @@ static void screen_set_on(bool on)
 
 #endif
 
-// --- Idle thread ---
+// --- Idle timeout ---
 
 #if CONFIG_DONGLE_SCREEN_IDLE_TIMEOUT_S > 0
 
-void screen_idle_thread(void)
+static void screen_idle_work_cb(struct k_work *work)
 {
-    while (1)
+    // Only act if the screen is on, or if it was turned off through the modifier
+    if (screen_on || off_through_modifier)
     {
-        // Thread should run even if the screen is off, but only if the screen is off through the modifier
-        if (screen_on || (!screen_on && off_through_modifier))
-        {
-            int64_t now = k_uptime_get();
-            int64_t elapsed = now - last_activity;
-            int64_t remaining = SCREEN_IDLE_TIMEOUT_MS - elapsed;
-
-            if (remaining <= 0)
-            {
-                screen_set_on(false);
-                off_through_modifier = false; // Reset the flag, because the screen is turned off
-                // After turning off, sleep until next activity (key event will wake screen)
-                k_sleep(K_FOREVER);
-            }
-            else
-            {
-                // Sleep exactly as long as needed until timeout or next key event
-                k_sleep(K_MSEC(remaining));
-            }
-        }
-        else
-        {
-            // If Screen is off, sleep forever (will be interrupted by key event)
-            k_sleep(K_FOREVER);
-        }
+        screen_set_on(false);
+        off_through_modifier = false; // Reset the flag, because the screen is turned off
     }
 }
 
-K_THREAD_DEFINE(screen_idle_tid, 512, screen_idle_thread, NULL, NULL, NULL, 7, 0, 0);
+static K_WORK_DELAYABLE_DEFINE(screen_idle_work, screen_idle_work_cb);
 
-void brightness_wake_screen_on_reconnect(void)
+// Restart the idle timeout, called for every activity
+static void screen_idle_restart(void)
 {
-    if (!screen_on)
-    {
-        LOG_INF("Peripheral reconnected, waking screen");
-
-        screen_set_on(true);
-
-        // Reset idle timer
-        last_activity = k_uptime_get();
-
-        k_wakeup(screen_idle_tid);
-    }
-    else
-    {
-        LOG_DBG("Peripheral reconnected but screen already on");
-    }
+    last_activity = k_uptime_get();
+    k_work_reschedule_for_queue(&brightness_work_q, &screen_idle_work, K_MSEC(SCREEN_IDLE_TIMEOUT_MS));
 }
 
 #endif
@@ -418,6 +390,7 @@ static void increase_brightness(void)
         brightness_modifier += safe_increase;
         LOG_DBG("Brightness modifier increased by %d to %d", safe_increase, brightness_modifier);
         set_screen_brightness(current_brightness, false);
+        brightness_schedule_save();
 
         // Check if we should turn screen on
         if (should_screen_turn_on(current_brightness, brightness_modifier) && off_through_modifier)
@@ -443,6 +416,7 @@ static void decrease_brightness(void)
         brightness_modifier += safe_decrease; // Adding a negative value decreases
         LOG_DBG("Brightness modifier decreased by %d to %d", -safe_decrease, brightness_modifier);
         set_screen_brightness(current_brightness, false);
+        brightness_schedule_save();
 
         // Check if we should turn screen off
         if (should_screen_turn_off(current_brightness, brightness_modifier))
@@ -462,6 +436,131 @@ static void decrease_brightness(void)
 
 #if CONFIG_DONGLE_SCREEN_IDLE_TIMEOUT_S > 0 || CONFIG_DONGLE_SCREEN_BRIGHTNESS_KEYBOARD_CONTROL
 
+// --- Screen events ---
+// Events from the key listener and the battery widget are handled on the brightness work queue,
+// so the screen state is only ever changed from one context. The key commands are queued in
+// order, plain activity (every key and layer change) only sets a flag that is handled once per
+// work run, so typing doesn't fill the queue.
+
+enum screen_event
+{
+    SCREEN_EVENT_BRIGHTNESS_UP,
+    SCREEN_EVENT_BRIGHTNESS_DOWN,
+    SCREEN_EVENT_TOGGLE,
+    SCREEN_EVENT_RECONNECT,
+};
+
+K_MSGQ_DEFINE(screen_event_msgq, sizeof(uint8_t), 8, 1);
+
+static void handle_screen_event(enum screen_event event)
+{
+    switch (event)
+    {
+#if CONFIG_DONGLE_SCREEN_BRIGHTNESS_KEYBOARD_CONTROL
+    case SCREEN_EVENT_BRIGHTNESS_UP:
+        increase_brightness();
+        break;
+    case SCREEN_EVENT_BRIGHTNESS_DOWN:
+        decrease_brightness();
+        break;
+    case SCREEN_EVENT_TOGGLE:
+        // Toggle screen on/off
+        if (screen_on)
+        {
+            off_through_modifier = true; // Track that the screen was turned off through the toggle key
+            screen_set_on(false);
+        }
+        else
+        {
+            screen_set_on(true);
+        }
+        break;
+#endif
+    case SCREEN_EVENT_RECONNECT:
+        if (!screen_on)
+        {
+            LOG_INF("Peripheral reconnected, waking screen");
+            screen_set_on(true);
+#if CONFIG_DONGLE_SCREEN_IDLE_TIMEOUT_S > 0
+            screen_idle_restart();
+#endif
+        }
+        else
+        {
+            LOG_DBG("Peripheral reconnected but screen already on");
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+static void handle_screen_activity(void)
+{
+#if CONFIG_DONGLE_SCREEN_IDLE_TIMEOUT_S > 0
+    screen_idle_restart();
+    if (!screen_on && !off_through_modifier)
+    {
+        screen_set_on(true);
+    }
+#else
+    // Without idle timeout: just turn on screen
+    if (!screen_on)
+    {
+        screen_set_on(true);
+    }
+#endif
+}
+
+static atomic_t activity_pending;
+
+static void screen_event_work_cb(struct k_work *work)
+{
+    uint8_t event;
+
+    while (k_msgq_get(&screen_event_msgq, &event, K_NO_WAIT) == 0)
+    {
+        handle_screen_event(event);
+    }
+
+    // All activity since the last run at once
+    if (atomic_clear(&activity_pending))
+    {
+        handle_screen_activity();
+    }
+}
+
+static K_WORK_DEFINE(screen_event_work, screen_event_work_cb);
+
+static void post_screen_event(enum screen_event event)
+{
+    uint8_t ev = event;
+
+    if (k_msgq_put(&screen_event_msgq, &ev, K_NO_WAIT) != 0)
+    {
+        LOG_WRN("Screen event queue full, dropping event %d", event);
+    }
+    k_work_submit_to_queue(&brightness_work_q, &screen_event_work);
+}
+
+static void post_screen_activity(void)
+{
+    // While the flag is set, a run of the work item is already pending
+    if (!atomic_set(&activity_pending, 1))
+    {
+        k_work_submit_to_queue(&brightness_work_q, &screen_event_work);
+    }
+}
+
+#if CONFIG_DONGLE_SCREEN_IDLE_TIMEOUT_S > 0
+
+void brightness_wake_screen_on_reconnect(void)
+{
+    post_screen_event(SCREEN_EVENT_RECONNECT);
+}
+
+#endif
+
 // --- Key event listener ---
 
 static int key_listener(const zmk_event_t *eh)
@@ -475,48 +574,26 @@ static int key_listener(const zmk_event_t *eh)
         if (ev->keycode == CONFIG_DONGLE_SCREEN_BRIGHTNESS_UP_KEYCODE)
         {
             LOG_INF("Brightness UP key recognized!");
-            increase_brightness();
+            post_screen_event(SCREEN_EVENT_BRIGHTNESS_UP);
             return 0;
         }
         else if (ev->keycode == CONFIG_DONGLE_SCREEN_BRIGHTNESS_DOWN_KEYCODE)
         {
             LOG_INF("Brightness DOWN key recognized!");
-            decrease_brightness();
+            post_screen_event(SCREEN_EVENT_BRIGHTNESS_DOWN);
             return 0;
         }
         else if (ev->keycode == CONFIG_DONGLE_SCREEN_TOGGLE_KEYCODE)
         {
             LOG_INF("Toggle screen key recognized!");
-            // Toggle screen on/off
-            if (screen_on)
-            {
-                off_through_modifier = true; // Track that the screen was turned off through the toggle key
-                screen_set_on(false);
-            }
-            else
-            {
-                screen_set_on(true);
-            }
+            post_screen_event(SCREEN_EVENT_TOGGLE);
             return 0;
         }
 
 #endif
     }
 
-#if CONFIG_DONGLE_SCREEN_IDLE_TIMEOUT_S > 0
-    last_activity = k_uptime_get();
-    if (!screen_on && !off_through_modifier)
-    {
-        screen_set_on(true);
-        k_wakeup(screen_idle_tid);
-    }
-#else
-    // Without idle thread: just turn on screen
-    if (!screen_on)
-    {
-        screen_set_on(true);
-    }
-#endif
+    post_screen_activity();
     return 0;
 }
 
@@ -528,26 +605,19 @@ ZMK_SUBSCRIPTION(screen_idle, zmk_layer_state_changed);
 
 #if IS_ENABLED(CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT)
 
+#if !IS_ENABLED(CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_INTERRUPT)
 #define AMBIENT_LIGHT_SENSOR_NODE DT_INST(0, avago_apds9960)
 static const struct device *ambient_sensor = DEVICE_DT_GET(AMBIENT_LIGHT_SENSOR_NODE);
+#endif
 
 // Passe diese Werte nach deinen Messungen an!
 const int32_t min_sensor = CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_MIN_RAW_VALUE;
 const int32_t max_sensor = CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_MAX_RAW_VALUE;
 
+// Pure mapping, called for the raw and the filtered reading
 static uint8_t ambient_to_brightness(int32_t sensor_value)
 {
-    if (sensor_value < min_sensor)
-    {
-        LOG_INF("Ambient sensor reading (%d) below DONGLE_SCREEN_AMBIENT_LIGHT_MIN_RAW_VALUE: (%d) Will set the sensor reading to the minimum configured.", sensor_value, CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_MIN_RAW_VALUE);
-        sensor_value = min_sensor;
-    }
-
-    if (sensor_value > max_sensor)
-    {
-        LOG_INF("Ambient sensor reading (%d) above DONGLE_SCREEN_AMBIENT_LIGHT_MAX_RAW_VALUE: (%d) Will set the sensor reading to the maximum configured.", sensor_value, CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_MAX_RAW_VALUE);
-        sensor_value = max_sensor;
-    }
+    sensor_value = CLAMP(sensor_value, min_sensor, max_sensor);
 
     uint8_t brightness = min_brightness +
                          ((sensor_value - min_sensor) * (max_brightness - min_brightness)) /
@@ -555,72 +625,222 @@ static uint8_t ambient_to_brightness(int32_t sensor_value)
     return clamp_brightness(brightness);
 }
 
-static void ambient_light_thread(void)
+static int64_t ambient_now_ms(void)
 {
-    struct sensor_value val;
-    uint8_t last_brightness = 0xFF; // Invalid initial value to force first update
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_TEST)
+    return ambient_trace_now_ms();
+#else
+    return k_uptime_get();
+#endif
+}
 
-    while (1)
+// Returns the brightness the filtered reading maps to
+static uint8_t ambient_light_evaluate(int32_t raw)
+{
+    static uint8_t last_brightness = 0xFF; // Invalid initial value to force first update
+
+    if (raw < min_sensor)
+    {
+        LOG_INF("Ambient sensor reading (%d) below DONGLE_SCREEN_AMBIENT_LIGHT_MIN_RAW_VALUE: (%d) Will set the sensor reading to the minimum configured.", raw, CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_MIN_RAW_VALUE);
+    }
+    else if (raw > max_sensor)
     {
+        LOG_INF("Ambient sensor reading (%d) above DONGLE_SCREEN_AMBIENT_LIGHT_MAX_RAW_VALUE: (%d) Will set the sensor reading to the maximum configured.", raw, CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_MAX_RAW_VALUE);
+    }
 
-#ifndef CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_TEST
+    // Filter stage: smooth out passing shadows and flicker before mapping to a brightness
+    int32_t filtered = ambient_filter_sample(raw);
+    uint8_t new_brightness = ambient_to_brightness(filtered);
+    bool exceeds = abs(new_brightness - last_brightness) > BRIGHTNESS_CHANGE_THRESHOLD;
+
+    // The first reading is applied right away, later changes have to hold for the hysteresis time
+    if (last_brightness == 0xFF ? exceeds : ambient_filter_hold(exceeds, ambient_now_ms()))
+    {
+        struct brightness_result result = calculate_brightness_with_bounds(new_brightness, brightness_modifier, true);
+
+        LOG_DBG("Ambient light: %d (raw), %d (filtered) -> brightness %d, effective (incl. modifier) %d",
+                raw, filtered, result.adjusted_brightness, result.effective_brightness);
 
-        if (!device_is_ready(ambient_sensor))
+        if (result.hit_min_limit)
         {
-            LOG_ERR("Ambient light sensor not ready!");
-            k_sleep(K_SECONDS(5));
-            continue;
+            LOG_DBG("Ambient brightness at minimum limit");
         }
-        int rc = sensor_sample_fetch(ambient_sensor);
-        if (rc == 0)
+        if (result.hit_max_limit)
         {
-            rc = sensor_channel_get(ambient_sensor, SENSOR_CHAN_LIGHT, &val);
-            if (rc == 0)
-            {
+            LOG_DBG("Ambient brightness at maximum limit");
+        }
+
+        if (screen_on)
+        {
+            set_screen_brightness(new_brightness, true);
+        }
+        else
+        {
+            // If the screen is off, just set the brightness variable
+            // to have the current ambient brightness when the screen is turned on again
+            current_brightness = result.adjusted_brightness;
+        }
+        last_brightness = new_brightness;
+    }
+    else if (ambient_filter_pending())
+    {
+        LOG_DBG("Ambient light: brightness %d held back by hysteresis", new_brightness);
+    }
+
+    return new_brightness;
+}
+
+static void ambient_light_work_cb(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(ambient_light_work, ambient_light_work_cb);
+
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_INTERRUPT)
+
+// Raw distance that moves the brightness by more than BRIGHTNESS_CHANGE_THRESHOLD
+#define AMBIENT_WINDOW_HALF                                                                          \
+    MAX(1, ((BRIGHTNESS_CHANGE_THRESHOLD + 1) * (CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_MAX_RAW_VALUE -  \
+                                                 CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_MIN_RAW_VALUE)) / \
+               (CONFIG_DONGLE_SCREEN_MAX_BRIGHTNESS - CONFIG_DONGLE_SCREEN_MIN_BRIGHTNESS + 1))
+
+static bool ambient_sensor_ready = false;
+
+static void ambient_light_irq(void)
+{
+    k_work_reschedule_for_queue(&brightness_work_q, &ambient_light_work, K_NO_WAIT);
+}
+
+// Sleep until the reading leaves a window around the current level. Readings beyond the
+// configured raw range map to the same brightness, so the window is open towards that side.
+static int ambient_light_arm(uint16_t raw)
+{
+    int32_t center = CLAMP(raw, min_sensor, max_sensor);
+    uint16_t low = center <= min_sensor ? 0 : MAX(center - AMBIENT_WINDOW_HALF, 0);
+    uint16_t high = center >= max_sensor ? UINT16_MAX : MIN(center + AMBIENT_WINDOW_HALF, UINT16_MAX);
+
+    LOG_DBG("Ambient light: %d (raw), next interrupt below %d or above %d", raw, low, high);
+    return apds9960_als_set_window(low, high);
+}
+
+static void ambient_light_work_cb(struct k_work *work)
+{
+    uint16_t raw;
+    int rc = 0;
+
+    if (!ambient_sensor_ready)
+    {
+        rc = apds9960_als_init(ambient_light_irq);
+        ambient_sensor_ready = rc == 0;
+    }
+    if (rc == 0)
+    {
+        rc = apds9960_als_read(&raw);
+    }
+    if (rc == -EAGAIN)
+    {
+        // Right after init the first conversion hasn't finished yet
+        k_work_schedule_for_queue(&brightness_work_q, &ambient_light_work, K_MSEC(APDS9960_ALS_CONVERSION_MS));
+        return;
+    }
+    if (rc == 0)
+    {
+        uint8_t filtered_brightness = ambient_light_evaluate(raw);
+
+        // Keep polling while the filter still converges or the hysteresis holds back a change,
+        // otherwise no further interrupt would come to finish them in a now stable room.
+        bool settled = filtered_brightness == ambient_to_brightness(raw) && !ambient_filter_pending();
+
+        if (!settled)
+        {
+            k_work_schedule_for_queue(&brightness_work_q, &ambient_light_work,
+                                      K_MSEC(CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_EVALUATION_INTERVAL_MS));
+            return;
+        }
+        rc = ambient_light_arm(raw);
+    }
+    if (rc < 0)
+    {
+        LOG_ERR("Ambient light sensor not ready!");
+        ambient_sensor_ready = false;
+        k_work_schedule_for_queue(&brightness_work_q, &ambient_light_work, K_SECONDS(5));
+    }
+}
+
 #else
-        k_sleep(K_SECONDS(10));
-        val.val1 = random0to100();
 
-#endif
-                uint8_t new_brightness = ambient_to_brightness(val.val1);
-
-                if (abs(new_brightness - last_brightness) > BRIGHTNESS_CHANGE_THRESHOLD)
-                {
-                    struct brightness_result result = calculate_brightness_with_bounds(new_brightness, brightness_modifier, true);
-
-                    LOG_DBG("Ambient light: %d (raw) -> brightness %d, effective (incl. modifier) %d",
-                            val.val1, result.adjusted_brightness, result.effective_brightness);
-
-                    if (result.hit_min_limit)
-                    {
-                        LOG_DBG("Ambient brightness at minimum limit");
-                    }
-                    if (result.hit_max_limit)
-                    {
-                        LOG_DBG("Ambient brightness at maximum limit");
-                    }
-
-                    if (screen_on)
-                    {
-                        set_screen_brightness(new_brightness, true);
-                    }
-                    else
-                    {
-                        // If the screen is off, just set the brightness variable
-                        // to have the current ambient brightness when the screen is turned on again
-                        current_brightness = result.adjusted_brightness;
-                    }
-                    last_brightness = new_brightness;
-                }
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_SAMPLING_ADAPTIVE)
+
+static uint32_t ambient_interval_ms = CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_EVALUATION_INTERVAL_MS;
+
+// Back off exponentially while the brightness is stable or the screen is off, and snap back to
+// the evaluation interval as soon as it changes.
+static uint32_t ambient_light_next_interval(uint8_t brightness)
+{
+    static uint8_t prev_brightness = 0xFF;
+    bool changed = abs(brightness - prev_brightness) > 1 || ambient_filter_pending();
+
+    prev_brightness = brightness;
+
+    if (screen_on && changed)
+    {
+        ambient_interval_ms = CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_EVALUATION_INTERVAL_MS;
+    }
+    else
+    {
+        ambient_interval_ms = MIN(ambient_interval_ms * 2, CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_MAX_INTERVAL_MS);
+    }
+
+    return ambient_interval_ms;
+}
+
+// Sample right away when the screen turns on, the reading may be long out of date
+static void ambient_light_wake(void)
+{
+    ambient_interval_ms = CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_EVALUATION_INTERVAL_MS;
+    k_work_reschedule_for_queue(&brightness_work_q, &ambient_light_work, K_NO_WAIT);
+}
+
+#else
+
+static uint32_t ambient_light_next_interval(uint8_t brightness)
+{
+    return CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_EVALUATION_INTERVAL_MS;
+}
+
+#endif // CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_SAMPLING_ADAPTIVE
+
+static void ambient_light_work_cb(struct k_work *work)
+{
 #ifndef CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_TEST
-            }
-        }
-#endif                                                                              // CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_TEST
-        k_sleep(K_MSEC(CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_EVALUATION_INTERVAL_MS)); // Adjust interval as needed
+    struct sensor_value val;
+
+    if (!device_is_ready(ambient_sensor))
+    {
+        LOG_ERR("Ambient light sensor not ready!");
+        k_work_schedule_for_queue(&brightness_work_q, &ambient_light_work, K_SECONDS(5));
+        return;
+    }
+
+    uint8_t brightness = current_brightness;
+    int rc = sensor_sample_fetch(ambient_sensor);
+    if (rc == 0)
+    {
+        rc = sensor_channel_get(ambient_sensor, SENSOR_CHAN_LIGHT, &val);
+    }
+    if (rc == 0)
+    {
+        brightness = ambient_light_evaluate(val.val1);
     }
+
+    k_work_schedule_for_queue(&brightness_work_q, &ambient_light_work, K_MSEC(ambient_light_next_interval(brightness)));
+#else
+    // Replay the light trace in accelerated time, the intervals run on the simulated clock
+    uint8_t brightness = ambient_light_evaluate(ambient_trace_read());
+
+    k_work_schedule_for_queue(&brightness_work_q, &ambient_light_work,
+                              ambient_trace_advance(ambient_light_next_interval(brightness)));
+#endif // CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_TEST
 }
 
-K_THREAD_DEFINE(ambient_light_tid, 512, ambient_light_thread, NULL, NULL, NULL, 7, 0, 0);
+#endif // CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_INTERRUPT
 
 #endif // CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT
 
@@ -628,13 +848,26 @@ K_THREAD_DEFINE(ambient_light_tid, 512, ambient_light_thread, NULL, NULL, NULL,
 
 static int init_fixed_brightness(void)
 {
+    k_work_queue_start(&brightness_work_q, brightness_work_q_stack,
+                       K_THREAD_STACK_SIZEOF(brightness_work_q_stack),
+                       CONFIG_DONGLE_SCREEN_BRIGHTNESS_WORK_QUEUE_PRIORITY, NULL);
+    k_thread_name_set(&brightness_work_q.thread, "brightness_wq");
+
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_BRIGHTNESS_PERSIST)
+    // Before the first brightness is applied, so the screen comes up at the saved level
+    brightness_load_state();
+#endif
+
     set_screen_brightness(current_brightness, false);
     last_activity = k_uptime_get();
 #if CONFIG_DONGLE_SCREEN_IDLE_TIMEOUT_S > 0
-    // Wake up the idle thread at boot
-    k_wakeup(screen_idle_tid);
+    // Start the idle timeout at boot
+    k_work_schedule_for_queue(&brightness_work_q, &screen_idle_work, K_MSEC(SCREEN_IDLE_TIMEOUT_MS));
 #else
     LOG_INF("Screen idle timeout disabled");
+#endif
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT)
+    k_work_schedule_for_queue(&brightness_work_q, &ambient_light_work, K_NO_WAIT);
 #endif
     return 0;
 }
@@ -6,6 +6,14 @@
 
 #pragma once
 
+#include <zephyr/kernel.h>
+
+/**
+ * @brief Work queue running all brightness handling: key events, idle timeout,
+ * ambient light sampling and fade steps
+ */
+extern struct k_work_q brightness_work_q;
+
 /**
  * @brief Wake the screen when a peripheral reconnects
  * Called by battery widget when it detects a peripheral reconnection
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdlib.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include "brightness_fade.h"
+#include "backlight.h"
+
+// Cubic ease-in-out ("S-curve": starts slow, accelerates, then slows again) sampled at
+// t = i / EASE_LUT_SEGMENTS and scaled to 0..EASE_ONE. Avoids float math and the FPU context.
+#define EASE_LUT_SEGMENTS 32
+#define EASE_SHIFT 10
+#define EASE_ONE (1 << EASE_SHIFT)
+
+static const uint16_t ease_lut[EASE_LUT_SEGMENTS + 1] = {
+    0,   0,   1,   3,   8,   16,  27,  43,  64,  91,   125,  166,  216,  275,  343,  422, 512,
+    602, 681, 749, 808, 858, 899, 933, 960, 981, 997, 1008, 1016, 1021, 1023, 1024, 1024,
+};
+
+// Interpolate the table at a position given in 1/256 entries
+static int32_t ease_lut_at(int32_t pos)
+{
+    int32_t idx = pos >> 8;
+    int32_t frac = pos & 0xFF;
+
+    if (idx >= EASE_LUT_SEGMENTS)
+    {
+        return EASE_ONE;
+    }
+
+    return ease_lut[idx] + (((ease_lut[idx + 1] - ease_lut[idx]) * frac) >> 8);
+}
+
+// Eased progress (0..EASE_ONE) of step out of steps
+static int32_t ease_in_out(int step, int steps)
+{
+    return ease_lut_at((step * EASE_LUT_SEGMENTS * 256) / steps);
+}
+
+// Second half of the S-curve stretched to the full range: starts at speed and slows down.
+// Used when retargeting a running fade so the brightness keeps moving instead of stalling.
+static int32_t ease_out(int step, int steps)
+{
+    int32_t half = EASE_LUT_SEGMENTS / 2;
+
+    return (ease_lut_at((half * 256) + (step * half * 256) / steps) - EASE_ONE / 2) * 2;
+}
+
+// Speed of the fade in flight, used to scale the duration of a retargeted fade
+static uint32_t fade_us_per_level;
+static struct k_spinlock fade_lock;
+
+void brightness_fade_to(uint8_t to)
+{
+    uint32_t start = k_cycle_get_32();
+    uint8_t levels[BACKLIGHT_SEQUENCE_MAX_LEN];
+
+    k_spinlock_key_t key = k_spin_lock(&fade_lock);
+
+    // Start where the backlight actually is, not where the previous fade was heading
+    uint8_t from = backlight_get();
+    bool retarget = backlight_busy();
+
+    // Calculate brightness difference and use it to determine number of steps
+    int diff = abs(to - from);
+
+    // Skip animation entirely if brightness difference is too small
+    if (diff <= 1)
+    {
+        k_spin_unlock(&fade_lock, key);
+        backlight_set(to);
+        return;
+    }
+
+    // More steps for smoother fades over large differences. The perceptual brightness curve makes
+    // every level an equally visible step, so one step per level is enough.
+    int steps = CLAMP(diff, 6, BACKLIGHT_SEQUENCE_MAX_LEN - 1);
+    uint32_t total_duration_us;
+
+    if (retarget)
+    {
+        // Keep the speed of the running fade, so the duration scales with the remaining distance
+        total_duration_us = CLAMP(diff * fade_us_per_level, 100 * 1000, 1000 * 1000);
+    }
+    else
+    {
+        // Set total animation time: scale with difference but clamp between 500ms and 1000ms
+        total_duration_us = CLAMP(diff * 20, 500, 1000) * 1000; // 20ms per level as baseline
+        fade_us_per_level = total_duration_us / diff;
+    }
+
+    uint32_t step_us = total_duration_us / steps;
+
+    k_spin_unlock(&fade_lock, key);
+
+    // Precompute the whole duty cycle sequence, the backend plays it back on its own
+    for (int i = 0; i <= steps; i++)
+    {
+        int32_t eased = retarget ? ease_out(i, steps) : ease_in_out(i, steps);
+        levels[i] = from + (((to - from) * eased + EASE_ONE / 2) >> EASE_SHIFT);
+    }
+    levels[steps] = to; // safeguard to ensure the target value is set at the end
+
+    // Outside the lock, the backend takes its own and reschedules its work
+    backlight_play(levels, steps + 1, step_us);
+
+    LOG_DBG("Fade %d -> %d%s: %d steps of %u us, %u us CPU time to prepare", from, to,
+            retarget ? " (retargeted)" : "", steps, step_us, k_cyc_to_us_floor32(k_cycle_get_32() - start));
+}
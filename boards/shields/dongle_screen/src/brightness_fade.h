@@ -0,0 +1,20 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Fade the backlight from its current level to another one
+ *
+ * The fade starts at the level currently applied to the backlight. If a fade is still
+ * running it is retargeted: the new fade continues at the same speed with an ease-out
+ * curve, so its duration scales with the remaining distance and there is no jump.
+ * The whole duty cycle sequence is computed up front and handed to the backlight backend.
+ * Safe to call from any thread.
+ */
+void brightness_fade_to(uint8_t to);
@@ -5,7 +5,11 @@
  */
 
 #include "custom_status_screen.h"
+#include "layout.h"
 
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_LVGL_MONITOR)
+#include "lvgl_monitor.h"
+#endif
 
 #include "widgets/brightness_status.h"
 struct zmk_widget_brightness_status brightness_status_widget;
@@ -46,62 +50,292 @@ static struct zmk_widget_hid_indicators hid_indicators_widget;
 #include <zephyr/logging/log.h>
 LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_LVGL_MONITOR)
+#include <zephyr/sys/mem_stats.h>
+#include <lvgl_mem.h>
+#endif
+
+#include <zmk/display.h>
+#include <zmk/event_manager.h>
+#include <zmk/events/keycode_state_changed.h>
+
 lv_style_t global_style;
 
-lv_obj_t *zmk_display_status_screen()
+// --- Widget constructors used by the layout descriptors ---
+
+#if CONFIG_DONGLE_SCREEN_HID_INDICATORS_ACTIVE
+static lv_obj_t *create_hid_indicators(lv_obj_t *parent)
 {
-    lv_obj_t *screen;
+    zmk_widget_hid_indicators_init(&hid_indicators_widget, parent);
+    return zmk_widget_hid_indicators_obj(&hid_indicators_widget);
+}
 
-    screen = lv_obj_create(NULL);
-    lv_obj_set_style_bg_color(screen, lv_color_hex(0x000000), LV_PART_MAIN);
-    lv_obj_set_style_bg_opa(screen, 255, LV_PART_MAIN);
+static void destroy_hid_indicators(void)
+{
+    zmk_widget_hid_indicators_deinit(&hid_indicators_widget);
+}
+#endif
 
-    lv_style_init(&global_style);
-    // lv_style_set_text_font(&global_style, &lv_font_unscii_8); // ToDo: Font is not recognized
-    lv_style_set_text_color(&global_style, lv_color_white());
-    lv_style_set_text_letter_space(&global_style, 1);
-    lv_style_set_text_line_space(&global_style, 1);
-    lv_obj_add_style(screen, &global_style, LV_PART_MAIN);
+#if CONFIG_DONGLE_SCREEN_OUTPUT_ACTIVE
+static lv_obj_t *create_output_status(lv_obj_t *parent)
+{
+    zmk_widget_output_status_init(&output_status_widget, parent);
+    return zmk_widget_output_status_obj(&output_status_widget);
+}
+
+static void destroy_output_status(void)
+{
+    zmk_widget_output_status_deinit(&output_status_widget);
+}
+#endif
+
+#if CONFIG_DONGLE_SCREEN_BATTERY_ACTIVE
+static lv_obj_t *create_battery_status(lv_obj_t *parent)
+{
+    zmk_widget_dongle_battery_status_init(&dongle_battery_status_widget, parent);
+    return zmk_widget_dongle_battery_status_obj(&dongle_battery_status_widget);
+}
+
+static void destroy_battery_status(void)
+{
+    zmk_widget_dongle_battery_status_deinit(&dongle_battery_status_widget);
+}
+#endif
+
+#if CONFIG_DONGLE_SCREEN_WPM_ACTIVE
+static lv_obj_t *create_wpm_status(lv_obj_t *parent)
+{
+    zmk_widget_wpm_status_init(&wpm_status_widget, parent);
+    return zmk_widget_wpm_status_obj(&wpm_status_widget);
+}
+
+static void destroy_wpm_status(void)
+{
+    zmk_widget_wpm_status_deinit(&wpm_status_widget);
+}
+#endif
 
-/*
 #if CONFIG_DONGLE_SCREEN_LAYER_ACTIVE
-    zmk_widget_layer_status_init(&layer_status_widget, screen);
-    lv_obj_align(zmk_widget_layer_status_obj(&layer_status_widget), LV_ALIGN_LEFT_MID, 20, -10);
+static lv_obj_t *create_layer_roller(lv_obj_t *parent)
+{
+    zmk_widget_layer_roller_init(&layer_roller_widget, parent);
+    return zmk_widget_layer_roller_obj(&layer_roller_widget);
+}
+
+static void destroy_layer_roller(void)
+{
+    zmk_widget_layer_roller_deinit(&layer_roller_widget);
+}
+#endif
+
+#if CONFIG_DONGLE_SCREEN_MODIFIER_ACTIVE
+static lv_obj_t *create_mod_status(lv_obj_t *parent)
+{
+    zmk_widget_mod_status_init(&mod_widget, parent);
+    return zmk_widget_mod_status_obj(&mod_widget);
+}
+
+static void destroy_mod_status(void)
+{
+    zmk_widget_mod_status_deinit(&mod_widget);
+}
 #endif
-*/
 
+static lv_obj_t *create_brightness_status(lv_obj_t *parent)
+{
+    zmk_widget_brightness_status_init(&brightness_status_widget, parent);
+    return zmk_widget_brightness_status_obj(&brightness_status_widget);
+}
+
+// --- Layout descriptors ---
+// Every widget owns one tile. Tiles must not overlap, so a widget update only redraws its own tile.
+// The layer status label is not part of the layout, the layer roller is used instead.
+
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_HORIZONTAL)
+// 280x240
+#define TILE_WPM DONGLE_SCREEN_TILE(10, 10, 135, 45)
+#define TILE_OUTPUT DONGLE_SCREEN_TILE(145, 10, 125, 50)
+#define TILE_LAYER_ROLLER DONGLE_SCREEN_TILE(10, 60, 180, 110)
+#define TILE_HID_INDICATORS DONGLE_SCREEN_TILE(190, 70, 80, 80)
+#define TILE_MODIFIER DONGLE_SCREEN_TILE(0, 170, 280, 42)
+#define TILE_BATTERY DONGLE_SCREEN_TILE(0, 212, 280, 28)
+#define TILE_BRIGHTNESS DONGLE_SCREEN_TILE(70, 85, 140, 70)
+
+#define TILE_STATISTICS_WPM DONGLE_SCREEN_TILE(10, 20, 170, 45)
+#define TILE_STATISTICS_HID_INDICATORS DONGLE_SCREEN_TILE(190, 20, 80, 80)
+#define TILE_STATISTICS_MODIFIER DONGLE_SCREEN_TILE(0, 130, 280, 45)
+
+#define TILE_BATTERY_PAGE_OUTPUT DONGLE_SCREEN_TILE(145, 10, 125, 50)
+#define TILE_BATTERY_PAGE_BATTERY DONGLE_SCREEN_TILE(0, 100, 280, 60)
+#else
+// 240x280
+#define TILE_WPM DONGLE_SCREEN_TILE(5, 10, 130, 45)
+#define TILE_OUTPUT DONGLE_SCREEN_TILE(135, 10, 100, 50)
+#define TILE_LAYER_ROLLER DONGLE_SCREEN_TILE(0, 65, 160, 110)
+#define TILE_HID_INDICATORS DONGLE_SCREEN_TILE(160, 80, 80, 80)
+#define TILE_MODIFIER DONGLE_SCREEN_TILE(0, 180, 240, 45)
+#define TILE_BATTERY DONGLE_SCREEN_TILE(0, 230, 240, 40)
+#define TILE_BRIGHTNESS DONGLE_SCREEN_TILE(50, 105, 140, 70)
+
+#define TILE_STATISTICS_WPM DONGLE_SCREEN_TILE(5, 20, 150, 45)
+#define TILE_STATISTICS_HID_INDICATORS DONGLE_SCREEN_TILE(160, 20, 80, 80)
+#define TILE_STATISTICS_MODIFIER DONGLE_SCREEN_TILE(0, 140, 240, 45)
+
+#define TILE_BATTERY_PAGE_OUTPUT DONGLE_SCREEN_TILE(135, 10, 100, 50)
+#define TILE_BATTERY_PAGE_BATTERY DONGLE_SCREEN_TILE(0, 120, 240, 60)
+#endif
+
+static const struct dongle_screen_layout_entry status_layout[] = {
 #if CONFIG_DONGLE_SCREEN_HID_INDICATORS_ACTIVE
-    zmk_widget_hid_indicators_init(&hid_indicators_widget, screen);
-    lv_obj_align(zmk_widget_hid_indicators_obj(&hid_indicators_widget), LV_ALIGN_RIGHT_MID, -15, 0);
+    {.name = "hid_indicators", .create = create_hid_indicators, .destroy = destroy_hid_indicators, .tile = TILE_HID_INDICATORS},
 #endif
-    
 #if CONFIG_DONGLE_SCREEN_OUTPUT_ACTIVE
-    zmk_widget_output_status_init(&output_status_widget, screen);
-    lv_obj_align(zmk_widget_output_status_obj(&output_status_widget), LV_ALIGN_TOP_RIGHT, -15, 15);
+    {.name = "output", .create = create_output_status, .destroy = destroy_output_status, .tile = TILE_OUTPUT},
 #endif
-
 #if CONFIG_DONGLE_SCREEN_BATTERY_ACTIVE
-    zmk_widget_dongle_battery_status_init(&dongle_battery_status_widget, screen);
-    lv_obj_align(zmk_widget_dongle_battery_status_obj(&dongle_battery_status_widget), LV_ALIGN_BOTTOM_MID, 0, 0);
+    {.name = "battery", .create = create_battery_status, .destroy = destroy_battery_status, .tile = TILE_BATTERY},
 #endif
-
 #if CONFIG_DONGLE_SCREEN_WPM_ACTIVE
-    zmk_widget_wpm_status_init(&wpm_status_widget, screen);
-    lv_obj_align(zmk_widget_wpm_status_obj(&wpm_status_widget), LV_ALIGN_TOP_LEFT, 15, 20);
+    {.name = "wpm", .create = create_wpm_status, .destroy = destroy_wpm_status, .tile = TILE_WPM},
 #endif
-
 #if CONFIG_DONGLE_SCREEN_LAYER_ACTIVE
-    zmk_widget_layer_roller_init(&layer_roller_widget, screen);
-    lv_obj_align(zmk_widget_layer_roller_obj(&layer_roller_widget), LV_ALIGN_LEFT_MID, 10, 0);
+    {.name = "layer_roller", .create = create_layer_roller, .destroy = destroy_layer_roller, .tile = TILE_LAYER_ROLLER},
+#endif
+#if CONFIG_DONGLE_SCREEN_MODIFIER_ACTIVE
+    {.name = "modifier", .create = create_mod_status, .destroy = destroy_mod_status, .tile = TILE_MODIFIER},
 #endif
+};
 
+#if CONFIG_DONGLE_SCREEN_PAGES
+static const struct dongle_screen_layout_entry statistics_layout[] = {
+#if CONFIG_DONGLE_SCREEN_WPM_ACTIVE
+    {.name = "wpm", .create = create_wpm_status, .destroy = destroy_wpm_status, .tile = TILE_STATISTICS_WPM},
+#endif
+#if CONFIG_DONGLE_SCREEN_HID_INDICATORS_ACTIVE
+    {.name = "hid_indicators", .create = create_hid_indicators, .destroy = destroy_hid_indicators, .tile = TILE_STATISTICS_HID_INDICATORS},
+#endif
 #if CONFIG_DONGLE_SCREEN_MODIFIER_ACTIVE
-    zmk_widget_mod_status_init(&mod_widget, screen);
-    lv_obj_align(zmk_widget_mod_status_obj(&mod_widget), LV_ALIGN_CENTER, 0, 70);
+    {.name = "modifier", .create = create_mod_status, .destroy = destroy_mod_status, .tile = TILE_STATISTICS_MODIFIER},
+#endif
+};
+
+static const struct dongle_screen_layout_entry battery_layout[] = {
+#if CONFIG_DONGLE_SCREEN_OUTPUT_ACTIVE
+    {.name = "output", .create = create_output_status, .destroy = destroy_output_status, .tile = TILE_BATTERY_PAGE_OUTPUT},
+#endif
+#if CONFIG_DONGLE_SCREEN_BATTERY_ACTIVE
+    {.name = "battery", .create = create_battery_status, .destroy = destroy_battery_status, .tile = TILE_BATTERY_PAGE_BATTERY},
+#endif
+};
+#endif // CONFIG_DONGLE_SCREEN_PAGES
+
+// The brightness popup is shared by all pages and stays on top of them.
+static const struct dongle_screen_layout_entry overlay_layout[] = {
+    {.name = "brightness", .create = create_brightness_status, .tile = TILE_BRIGHTNESS, .overlay = true},
+};
+
+// --- Pages ---
+// Only the visible page exists in the LVGL heap. It is built when shown and deleted when hidden.
+
+struct dongle_screen_page
+{
+    const char *name;
+    const struct dongle_screen_layout_entry *entries;
+    size_t count;
+};
+
+static const struct dongle_screen_page pages[] = {
+    {.name = "status", .entries = status_layout, .count = ARRAY_SIZE(status_layout)},
+#if CONFIG_DONGLE_SCREEN_PAGES
+    {.name = "statistics", .entries = statistics_layout, .count = ARRAY_SIZE(statistics_layout)},
+    {.name = "battery", .entries = battery_layout, .count = ARRAY_SIZE(battery_layout)},
+#endif
+};
+
+static lv_obj_t *page_root;
+static uint8_t current_page;
+
+static void page_show(uint8_t index)
+{
+    const struct dongle_screen_page *page = &pages[index];
+
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_LVGL_MONITOR)
+    // The heap stats need SYS_HEAP_RUNTIME_STATS, which only the monitor enables
+    struct sys_memory_stats before, after;
+
+    lvgl_heap_stats(&before);
+#endif
+
+    if (dongle_screen_layout_apply(page_root, page->entries, page->count) < 0)
+    {
+        LOG_ERR("Layout of page '%s' is invalid, widgets may overlap", page->name);
+    }
+
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_LVGL_MONITOR)
+    lvgl_heap_stats(&after);
+
+    LOG_INF("Page '%s' shown, uses %d bytes of LVGL heap (%zu of %zu bytes free)", page->name,
+            (int)(after.allocated_bytes - before.allocated_bytes), after.free_bytes,
+            after.free_bytes + after.allocated_bytes);
+#else
+    LOG_INF("Page '%s' shown", page->name);
+#endif
+}
+
+#if CONFIG_DONGLE_SCREEN_PAGES
+
+static void page_switch_work_cb(struct k_work *work)
+{
+    const struct dongle_screen_page *page = &pages[current_page];
+
+    dongle_screen_layout_remove(page_root, page->entries, page->count);
+    current_page = (current_page + 1) % ARRAY_SIZE(pages);
+    page_show(current_page);
+}
+
+static K_WORK_DEFINE(page_switch_work, page_switch_work_cb);
+
+// Page switching is only requested here, LVGL is touched on the display work queue.
+static int page_key_listener(const zmk_event_t *eh)
+{
+    const struct zmk_keycode_state_changed *ev = as_zmk_keycode_state_changed(eh);
+    if (ev && ev->state && ev->keycode == CONFIG_DONGLE_SCREEN_PAGE_KEYCODE && page_root)
+    {
+        LOG_INF("Page switch key recognized!");
+        k_work_submit_to_queue(zmk_display_work_q(), &page_switch_work);
+    }
+    return 0;
+}
+
+ZMK_LISTENER(dongle_screen_pages, page_key_listener);
+ZMK_SUBSCRIPTION(dongle_screen_pages, zmk_keycode_state_changed);
+
+#endif // CONFIG_DONGLE_SCREEN_PAGES
+
+lv_obj_t *zmk_display_status_screen()
+{
+    lv_obj_t *screen;
+
+    screen = lv_obj_create(NULL);
+    lv_obj_set_style_bg_color(screen, lv_color_hex(0x000000), LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(screen, 255, LV_PART_MAIN);
+
+    lv_style_init(&global_style);
+    // lv_style_set_text_font(&global_style, &lv_font_unscii_8); // ToDo: Font is not recognized
+    lv_style_set_text_color(&global_style, lv_color_white());
+    lv_style_set_text_letter_space(&global_style, 1);
+    lv_style_set_text_line_space(&global_style, 1);
+    lv_obj_add_style(screen, &global_style, LV_PART_MAIN);
+
+    page_root = dongle_screen_layout_create_root(screen);
+    current_page = 0;
+    page_show(current_page);
+
+    dongle_screen_layout_apply(screen, overlay_layout, ARRAY_SIZE(overlay_layout));
+
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_LVGL_MONITOR)
+    dongle_screen_lvgl_monitor_start();
 #endif
-    
-    zmk_widget_brightness_status_init(&brightness_status_widget, screen);
-    lv_obj_align(zmk_widget_brightness_status_obj(&brightness_status_widget), LV_ALIGN_CENTER, 0, 0);
 
     return screen;
 }
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include "layout.h"
+
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_LVGL_MONITOR)
+#include "lvgl_monitor.h"
+#endif
+
+static void tile_to_area(const struct dongle_screen_tile *tile, lv_area_t *area)
+{
+    area->x1 = tile->x;
+    area->y1 = tile->y;
+    area->x2 = tile->x + tile->w - 1;
+    area->y2 = tile->y + tile->h - 1;
+}
+
+static int validate_layout(const struct dongle_screen_layout_entry *entries, size_t count)
+{
+    int32_t hor_res = lv_display_get_horizontal_resolution(NULL);
+    int32_t ver_res = lv_display_get_vertical_resolution(NULL);
+    int ret = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const struct dongle_screen_tile *tile = &entries[i].tile;
+
+        if (tile->w <= 0 || tile->h <= 0 || tile->x < 0 || tile->y < 0 ||
+            tile->x + tile->w > hor_res || tile->y + tile->h > ver_res)
+        {
+            LOG_ERR("Layout: tile '%s' (%d,%d %dx%d) is outside of the %dx%d screen",
+                    entries[i].name, tile->x, tile->y, tile->w, tile->h, hor_res, ver_res);
+            ret = -EINVAL;
+        }
+
+        if (entries[i].overlay)
+        {
+            continue;
+        }
+
+        lv_area_t a;
+        tile_to_area(tile, &a);
+
+        for (size_t j = i + 1; j < count; j++)
+        {
+            if (entries[j].overlay)
+            {
+                continue;
+            }
+
+            lv_area_t b, common;
+            tile_to_area(&entries[j].tile, &b);
+
+            if (lv_area_intersect(&common, &a, &b))
+            {
+                LOG_ERR("Layout: tiles '%s' and '%s' overlap", entries[i].name, entries[j].name);
+                ret = -EINVAL;
+            }
+        }
+    }
+
+    return ret;
+}
+
+// Turn a widget root into a plain, clipping tile so its dirty area never leaks into a neighbour.
+static void place_in_tile(lv_obj_t *obj, const struct dongle_screen_tile *tile, bool overlay)
+{
+    lv_obj_set_pos(obj, tile->x, tile->y);
+    lv_obj_set_size(obj, tile->w, tile->h);
+
+    lv_obj_set_style_pad_all(obj, 0, LV_PART_MAIN);
+    lv_obj_set_style_border_width(obj, 0, LV_PART_MAIN);
+    lv_obj_set_style_outline_width(obj, 0, LV_PART_MAIN);
+    lv_obj_set_style_shadow_width(obj, 0, LV_PART_MAIN);
+    lv_obj_set_scrollbar_mode(obj, LV_SCROLLBAR_MODE_OFF);
+    lv_obj_remove_flag(obj, LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_OVERFLOW_VISIBLE);
+
+    if (!overlay)
+    {
+        lv_obj_set_style_bg_opa(obj, LV_OPA_TRANSP, LV_PART_MAIN);
+    }
+}
+
+lv_obj_t *dongle_screen_layout_create_root(lv_obj_t *screen)
+{
+    lv_obj_t *root = lv_obj_create(screen);
+    const struct dongle_screen_tile full = DONGLE_SCREEN_TILE(
+        0, 0, lv_display_get_horizontal_resolution(NULL), lv_display_get_vertical_resolution(NULL));
+
+    place_in_tile(root, &full, false);
+    return root;
+}
+
+void dongle_screen_layout_remove(lv_obj_t *parent, const struct dongle_screen_layout_entry *entries,
+                                 size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if (entries[i].destroy)
+        {
+            entries[i].destroy();
+        }
+    }
+
+    lv_obj_clean(parent);
+}
+
+int dongle_screen_layout_apply(lv_obj_t *screen, const struct dongle_screen_layout_entry *entries,
+                               size_t count)
+{
+    int ret = validate_layout(entries, count);
+
+    for (size_t i = 0; i < count; i++)
+    {
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_LVGL_MONITOR)
+        size_t heap_before = dongle_screen_lvgl_monitor_heap_used();
+#endif
+
+        lv_obj_t *obj = entries[i].create(screen);
+        if (!obj)
+        {
+            LOG_ERR("Layout: failed to create widget '%s'", entries[i].name);
+            ret = -ENOMEM;
+            continue;
+        }
+
+        place_in_tile(obj, &entries[i].tile, entries[i].overlay);
+
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_LVGL_MONITOR)
+        dongle_screen_lvgl_monitor_record_widget(
+            entries[i].name, (int32_t)(dongle_screen_lvgl_monitor_heap_used() - heap_before));
+#endif
+        LOG_DBG("Layout: '%s' placed at %d,%d %dx%d", entries[i].name, entries[i].tile.x,
+                entries[i].tile.y, entries[i].tile.w, entries[i].tile.h);
+    }
+
+    return ret;
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+#include <zephyr/sys/util.h>
+
+/**
+ * @brief A rectangular region of the screen owned by exactly one widget
+ */
+struct dongle_screen_tile
+{
+    int16_t x;
+    int16_t y;
+    int16_t w;
+    int16_t h;
+};
+
+#define DONGLE_SCREEN_TILE(_x, _y, _w, _h) {.x = (_x), .y = (_y), .w = (_w), .h = (_h)}
+
+/**
+ * @brief One entry of a screen layout descriptor
+ *
+ * Overlays (e.g. the brightness popup) are drawn on top of the other tiles and
+ * are therefore excluded from the overlap check.
+ */
+struct dongle_screen_layout_entry
+{
+    const char *name;
+    lv_obj_t *(*create)(lv_obj_t *parent);
+    void (*destroy)(void); // Optional, detaches the widget before its objects are deleted
+    struct dongle_screen_tile tile;
+    bool overlay;
+};
+
+/**
+ * @brief Create every widget of a layout and place it into its tile
+ *
+ * Widgets are created in table order. Each widget root is resized to its tile,
+ * stripped of padding, border and scrollbars and clips its children, so an
+ * update inside one widget only ever invalidates the area of its own tile.
+ * Widgets don't size their root themselves, the tile is the only source of it.
+ *
+ * @return 0 on success, -EINVAL if two non-overlay tiles overlap or a tile is off screen
+ */
+int dongle_screen_layout_apply(lv_obj_t *screen, const struct dongle_screen_layout_entry *entries,
+                               size_t count);
+
+/**
+ * @brief Detach all widgets of a layout and delete their objects
+ *
+ * Calls the destroy hook of every entry and then deletes all children of @p parent,
+ * returning their memory to the LVGL heap.
+ */
+void dongle_screen_layout_remove(lv_obj_t *parent, const struct dongle_screen_layout_entry *entries,
+                                 size_t count);
+
+/**
+ * @brief Create a transparent full-screen container to hold the tiles of one layout
+ */
+lv_obj_t *dongle_screen_layout_create_root(lv_obj_t *screen);
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/mem_stats.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <lvgl.h>
+#include <lvgl_mem.h>
+#include <zmk/display.h>
+
+#if IS_ENABLED(CONFIG_SHELL)
+#include <zephyr/shell/shell.h>
+#endif
+
+#include "lvgl_monitor.h"
+
+#define MAX_TRACKED_WIDGETS 16
+
+struct widget_alloc
+{
+    const char *name;
+    int32_t last_bytes;       // Heap allocated by the latest creation
+    int64_t total_bytes;      // Heap allocated by all creations
+    uint32_t created;         // Number of times the widget was created
+    int64_t first_created_ms; // Uptime of the first creation, the rate is averaged from there
+};
+
+static struct widget_alloc widget_allocs[MAX_TRACKED_WIDGETS];
+static size_t peak_used;
+static size_t last_logged_used;
+
+size_t dongle_screen_lvgl_monitor_heap_used(void)
+{
+    struct sys_memory_stats stats;
+
+    lvgl_heap_stats(&stats);
+    return stats.allocated_bytes;
+}
+
+static lv_obj_tree_walk_res_t count_obj_walk_cb(lv_obj_t *obj, void *user_data)
+{
+    (*(uint32_t *)user_data)++;
+    return LV_OBJ_TREE_WALK_NEXT;
+}
+
+void dongle_screen_lvgl_monitor_sample(struct dongle_screen_lvgl_stats *stats)
+{
+    struct sys_memory_stats heap;
+
+    lvgl_heap_stats(&heap);
+
+    stats->used_bytes = heap.allocated_bytes;
+    stats->free_bytes = heap.free_bytes;
+    stats->total_bytes = heap.allocated_bytes + heap.free_bytes;
+    peak_used = MAX(peak_used, MAX(heap.max_allocated_bytes, heap.allocated_bytes));
+    stats->peak_bytes = peak_used;
+
+    stats->obj_count = 0;
+    lv_obj_tree_walk(lv_screen_active(), count_obj_walk_cb, &stats->obj_count);
+    lv_obj_tree_walk(lv_layer_top(), count_obj_walk_cb, &stats->obj_count);
+    lv_obj_tree_walk(lv_layer_sys(), count_obj_walk_cb, &stats->obj_count);
+
+    stats->timer_count = 0;
+    for (lv_timer_t *timer = lv_timer_get_next(NULL); timer; timer = lv_timer_get_next(timer))
+    {
+        stats->timer_count++;
+    }
+
+    if (stats->used_bytes > CONFIG_DONGLE_SCREEN_LVGL_HEAP_BUDGET)
+    {
+        LOG_ERR("LVGL heap usage %zu bytes exceeds the budget of %d bytes", stats->used_bytes,
+                CONFIG_DONGLE_SCREEN_LVGL_HEAP_BUDGET);
+    }
+}
+
+bool dongle_screen_lvgl_monitor_within_budget(const struct dongle_screen_lvgl_stats *stats)
+{
+    return stats->used_bytes <= CONFIG_DONGLE_SCREEN_LVGL_HEAP_BUDGET;
+}
+
+void dongle_screen_lvgl_monitor_record_widget(const char *name, int32_t bytes)
+{
+    for (size_t i = 0; i < ARRAY_SIZE(widget_allocs); i++)
+    {
+        struct widget_alloc *alloc = &widget_allocs[i];
+
+        if (alloc->name == NULL || alloc->name == name || strcmp(alloc->name, name) == 0)
+        {
+            if (alloc->created == 0)
+            {
+                alloc->first_created_ms = k_uptime_get();
+            }
+            alloc->name = name;
+            alloc->last_bytes = bytes;
+            alloc->total_bytes += bytes;
+            alloc->created++;
+            return;
+        }
+    }
+
+    LOG_WRN("LVGL monitor: no slot left to track widget '%s'", name);
+}
+
+#define STATS_FMT "LVGL heap: %zu/%zu bytes used, %zu free, peak %zu, %u objects, %u timers"
+#define STATS_ARGS(s)                                                                              \
+    (s)->used_bytes, (s)->total_bytes, (s)->free_bytes, (s)->peak_bytes, (s)->obj_count,           \
+        (s)->timer_count
+
+#if CONFIG_DONGLE_SCREEN_LVGL_MONITOR_INTERVAL_S > 0
+
+static void monitor_work_cb(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(monitor_work, monitor_work_cb);
+
+static void monitor_work_cb(struct k_work *work)
+{
+    struct dongle_screen_lvgl_stats stats;
+
+    dongle_screen_lvgl_monitor_sample(&stats);
+
+    LOG_INF(STATS_FMT, STATS_ARGS(&stats));
+    LOG_INF("LVGL heap changed by %d bytes in the last %d s",
+            (int)(stats.used_bytes - last_logged_used), CONFIG_DONGLE_SCREEN_LVGL_MONITOR_INTERVAL_S);
+    last_logged_used = stats.used_bytes;
+
+    k_work_schedule_for_queue(zmk_display_work_q(), &monitor_work,
+                              K_SECONDS(CONFIG_DONGLE_SCREEN_LVGL_MONITOR_INTERVAL_S));
+}
+
+#endif
+
+void dongle_screen_lvgl_monitor_start(void)
+{
+    last_logged_used = dongle_screen_lvgl_monitor_heap_used();
+
+#if CONFIG_DONGLE_SCREEN_LVGL_MONITOR_INTERVAL_S > 0
+    k_work_schedule_for_queue(zmk_display_work_q(), &monitor_work,
+                              K_SECONDS(CONFIG_DONGLE_SCREEN_LVGL_MONITOR_INTERVAL_S));
+#endif
+}
+
+#if IS_ENABLED(CONFIG_SHELL)
+
+// The object tree may only be walked from the display work queue, so the shell waits for it.
+static struct dongle_screen_lvgl_stats shell_stats;
+static K_SEM_DEFINE(shell_stats_sem, 0, 1);
+
+static void shell_sample_work_cb(struct k_work *work)
+{
+    dongle_screen_lvgl_monitor_sample(&shell_stats);
+    k_sem_give(&shell_stats_sem);
+}
+
+static K_WORK_DEFINE(shell_sample_work, shell_sample_work_cb);
+
+static int cmd_lvgl(const struct shell *sh, size_t argc, char **argv)
+{
+    k_sem_reset(&shell_stats_sem);
+    k_work_submit_to_queue(zmk_display_work_q(), &shell_sample_work);
+
+    if (k_sem_take(&shell_stats_sem, K_SECONDS(1)) != 0)
+    {
+        shell_error(sh, "Display work queue did not respond");
+        return -ETIMEDOUT;
+    }
+
+    shell_print(sh, STATS_FMT, STATS_ARGS(&shell_stats));
+    shell_print(sh, "Budget: %d bytes", CONFIG_DONGLE_SCREEN_LVGL_HEAP_BUDGET);
+
+    for (size_t i = 0; i < ARRAY_SIZE(widget_allocs) && widget_allocs[i].name; i++)
+    {
+        const struct widget_alloc *alloc = &widget_allocs[i];
+        // At least one minute, a widget created just now has no meaningful rate yet
+        int64_t minutes = MAX((k_uptime_get() - alloc->first_created_ms) / (60 * 1000), 1);
+
+        shell_print(sh, "  %-16s %6d bytes, created %u times, %d bytes/min", alloc->name,
+                    alloc->last_bytes, alloc->created, (int)(alloc->total_bytes / minutes));
+    }
+
+    return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_dongle_screen,
+                               SHELL_CMD(lvgl, NULL, "Show LVGL heap and object usage", cmd_lvgl),
+                               SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(dongle_screen, &sub_dongle_screen, "Dongle screen commands", NULL);
+
+#endif // IS_ENABLED(CONFIG_SHELL)
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Snapshot of the LVGL heap and object usage
+ */
+struct dongle_screen_lvgl_stats
+{
+    size_t total_bytes;
+    size_t used_bytes;
+    size_t free_bytes;
+    size_t peak_bytes;         // High watermark since boot
+    uint32_t obj_count;        // Live objects on the active screen and the top/sys layers
+    uint32_t timer_count;      // Live lv_timers
+};
+
+/**
+ * @brief Start the periodic LVGL usage log, called once the status screen exists
+ */
+void dongle_screen_lvgl_monitor_start(void);
+
+/**
+ * @brief Take a snapshot of the current LVGL usage
+ *
+ * Must be called from the display work queue, because the object tree is walked.
+ */
+void dongle_screen_lvgl_monitor_sample(struct dongle_screen_lvgl_stats *stats);
+
+/**
+ * @brief Whether a snapshot stays within CONFIG_DONGLE_SCREEN_LVGL_HEAP_BUDGET
+ */
+bool dongle_screen_lvgl_monitor_within_budget(const struct dongle_screen_lvgl_stats *stats);
+
+/**
+ * @brief Record the heap allocated while creating a widget
+ *
+ * The shell shows the latest creation and the average bytes per minute allocated by all
+ * creations of the widget.
+ */
+void dongle_screen_lvgl_monitor_record_widget(const char *name, int32_t bytes);
+
+/**
+ * @brief Read the number of bytes currently allocated from the LVGL heap
+ *
+ * Safe to call from any context.
+ */
+size_t dongle_screen_lvgl_monitor_heap_used(void);
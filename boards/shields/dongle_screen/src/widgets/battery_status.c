@@ -13,47 +13,68 @@ LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 #include <zmk/usb.h>
 
 #include "battery_status.h"
+#include "retained.h"
 #include "../brightness.h"
 
-#if IS_ENABLED(CONFIG_ZMK_DONGLE_DISPLAY_DONGLE_BATTERY)
-#define SOURCE_OFFSET 1
-#else
-#define SOURCE_OFFSET 0
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_BATTERY_ESTIMATE)
+#include "../battery_history.h"
 #endif
 
-#define BATT_BAR_LENGTH 100
-#define BATT_BAR_HEIGHT 14
 #define BATT_BAR_MAX 100
 #define BATT_BAR_MIN 0
 
-static sys_slist_t widgets = SYS_SLIST_STATIC_INIT(&widgets);
+/*
+ * Grid layout for any number of sources: up to three bars share one row, more sources are
+ * split over two rows of thinner bars. Widths and positions are relative to the widget, so
+ * the grid follows whatever tile the layout assigns.
+ */
+#define BATT_MAX_SINGLE_ROW 3
+#define BATT_COLUMNS                                                                               \
+    (BATTERY_SOURCE_COUNT <= BATT_MAX_SINGLE_ROW ? BATTERY_SOURCE_COUNT                           \
+                                                 : DIV_ROUND_UP(BATTERY_SOURCE_COUNT, 2))
+#define BATT_ROWS DIV_ROUND_UP(BATTERY_SOURCE_COUNT, BATT_COLUMNS)
+
+// Empty space on either side of a bar, in percent of the widget width
+#define BATT_BAR_GAP_PCT 4
+#define BATT_BAR_WIDTH_PCT (100 / BATT_COLUMNS - 2 * BATT_BAR_GAP_PCT)
+#define BATT_BAR_HEIGHT (BATT_ROWS > 1 ? 11 : 14)
+#define BATT_ROW_GAP 3
+
+// Four or more columns leave about 40 px per bar, enough for the level but not for "87 12h"
+#define BATT_SHOW_TIME_LEFT (BATT_COLUMNS <= BATT_MAX_SINGLE_ROW)
+
+BUILD_ASSERT(BATTERY_SOURCE_COUNT > 0, "The battery widget needs at least one battery source");
 
 struct battery_state {
     uint8_t source;
     uint8_t level;
     bool usb_present;
+    int32_t minutes_left; // -1 if unknown
 };
 
-struct battery_object {
-    lv_obj_t *bar;
-} battery_objects[ZMK_SPLIT_CENTRAL_PERIPHERAL_COUNT + SOURCE_OFFSET];
-
 /* Styles (initialized once) */
 static lv_style_t style_bg;
 static lv_style_t style_indic;
+static lv_style_t style_label;
 static bool styles_initialized = false;
 
 /* Peripheral tracking */
-static int8_t last_battery_levels[ZMK_SPLIT_CENTRAL_PERIPHERAL_COUNT + SOURCE_OFFSET];
+static int8_t last_battery_levels[BATTERY_SOURCE_COUNT];
 
 static void init_peripheral_tracking(void) {
-    for (int i = 0; i < (ZMK_SPLIT_CENTRAL_PERIPHERAL_COUNT + SOURCE_OFFSET); i++) {
+    static bool tracking_initialized = false;
+    if (tracking_initialized) {
+        return;
+    }
+    tracking_initialized = true;
+
+    for (int i = 0; i < BATTERY_SOURCE_COUNT; i++) {
         last_battery_levels[i] = -1;
     }
 }
 
 static bool is_peripheral_reconnecting(uint8_t source, uint8_t new_level) {
-    if (source >= (ZMK_SPLIT_CENTRAL_PERIPHERAL_COUNT + SOURCE_OFFSET)) {
+    if (source >= BATTERY_SOURCE_COUNT) {
         return false;
     }
 
@@ -68,50 +89,129 @@ static bool is_peripheral_reconnecting(uint8_t source, uint8_t new_level) {
     return reconnecting;
 }
 
-/* LVGL v9 draw event */
-static void event_cb(lv_event_t *e)
-{
-    lv_draw_task_t *draw_task = lv_event_get_draw_task(e);
-    if (!draw_task) return;
+/* Helper for battery color */
+static lv_color_t get_battery_color(uint8_t level) {
+    if (level <= 10) return lv_palette_main(LV_PALETTE_RED);
+    if (level <= 20) return lv_palette_main(LV_PALETTE_ORANGE);
+    if (level <= 30) return lv_palette_main(LV_PALETTE_YELLOW);
+    if (level <= 90) return lv_palette_main(LV_PALETTE_GREEN);
+    return lv_palette_main(LV_PALETTE_INDIGO);
+}
 
-    lv_draw_dsc_base_t *base = lv_draw_task_get_draw_dsc(draw_task);
-    if (!base || base->part != LV_PART_INDICATOR) return;
+/*
+ * The percentage sits in the middle of the bar, where the edge of the indicator can run through
+ * the text. The label has its own dark background, so the white text reads the same on the
+ * filled and the empty part.
+ */
+static void apply_battery_label(lv_obj_t *label, uint8_t level, int32_t minutes_left) {
+    char text[12];
+
+    // Level 0 is a disconnected peripheral, there is nothing to estimate
+    if (minutes_left < 0 || level == 0 || !BATT_SHOW_TIME_LEFT) {
+        lv_snprintf(text, sizeof(text), "%d", level);
+    } else if (minutes_left < 60) {
+        lv_snprintf(text, sizeof(text), "%d %dm", level, (int)minutes_left);
+    } else {
+        lv_snprintf(text, sizeof(text), "%d %dh", level, (int)MIN(minutes_left / 60, 99));
+    }
 
-    lv_obj_t *obj = lv_event_get_target(e);
+    // Only re-rendered when the level changes, the digits come from the font bitmaps
+    retained_label_set_text(label, text);
+}
 
-    char buf[8];
-    lv_snprintf(buf, sizeof(buf), "%d", (int)lv_bar_get_value(obj));
+static void apply_battery_level(lv_obj_t *bar, lv_obj_t *label, uint8_t level,
+                                int32_t minutes_left, lv_anim_enable_t anim) {
+    if (lv_bar_get_value(bar) != level) {
+        lv_bar_set_value(bar, level, anim);
+    }
 
-    lv_draw_label_dsc_t dsc;
-    lv_draw_label_dsc_init(&dsc);
+    apply_battery_label(label, level, minutes_left);
 
-    /* ✅ Correct way to get draw area */
-    lv_area_t draw_task_area;
-    lv_draw_task_get_area(draw_task, &draw_task_area);
+    lv_color_t color = get_battery_color(level);
 
-    /* ✅ Correct way to get draw context */
-    lv_draw_ctx_t draw_ctx;
-    lv_draw_task_get_draw_ctx(draw_task);
+    retained_set_border_color(bar, color, LV_PART_MAIN);
+    retained_set_bg_color(bar, color, LV_PART_INDICATOR);
 
-    if (!draw_task_area || !draw_ctx) return;
+    // The bars never overlap, so there is no need to raise them
+    retained_set_hidden(bar, false);
+}
 
-    lv_draw_label(draw_ctx, &dsc, draw_task_area, buf, NULL);
+static void battery_status_apply(struct widget_instance *instance, const void *state) {
+    struct zmk_widget_dongle_battery_status *widget =
+        CONTAINER_OF(instance, struct zmk_widget_dongle_battery_status, instance);
+    const struct battery_state *battery = state;
+
+    apply_battery_level(widget->bars[battery->source], widget->labels[battery->source],
+                        battery->level, battery->minutes_left, LV_ANIM_ON);
 }
 
-/* Helper for battery color */
-static lv_color_t get_battery_color(uint8_t level) {
-    if (level <= 10) return lv_palette_main(LV_PALETTE_RED);
-    if (level <= 20) return lv_palette_main(LV_PALETTE_ORANGE);
-    if (level <= 30) return lv_palette_main(LV_PALETTE_YELLOW);
-    if (level <= 90) return lv_palette_main(LV_PALETTE_GREEN);
-    return lv_palette_main(LV_PALETTE_INDIGO);
+static int32_t battery_minutes_left(uint8_t source) {
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_BATTERY_ESTIMATE)
+    return battery_history_minutes_remaining(source, k_uptime_get());
+#else
+    return -1;
+#endif
 }
 
-static void set_battery_symbol(lv_obj_t *widget, struct battery_state state) {
-    if (state.source >= ZMK_SPLIT_CENTRAL_PERIPHERAL_COUNT + SOURCE_OFFSET) {
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_BATTERY_ESTIMATE) && BATT_SHOW_TIME_LEFT
+
+#define BATT_ESTIMATE_REFRESH K_MINUTES(1)
+
+/*
+ * Battery events can be many minutes apart, and the estimate counts down in between. While a
+ * time left is shown, the labels are recomputed once a minute. The retained setter skips the
+ * labels whose text didn't change, and the refresh stops once no source has an estimate.
+ */
+static void battery_estimate_refresh_cb(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(battery_estimate_refresh, battery_estimate_refresh_cb);
+
+static void battery_estimate_refresh_cb(struct k_work *work) {
+    bool shown = false;
+
+    for (int i = 0; i < BATTERY_SOURCE_COUNT; i++) {
+        if (last_battery_levels[i] < 1) {
+            continue;
+        }
+
+        struct battery_state state = {
+            .source = i,
+            .level = last_battery_levels[i],
+            .minutes_left = battery_minutes_left(i),
+        };
+
+        shown |= state.minutes_left >= 0;
+        widget_registry_dispatch(WIDGET_SLOT_BATTERY, &state);
+    }
+
+    if (shown) {
+        k_work_schedule_for_queue(zmk_display_work_q(), &battery_estimate_refresh,
+                                  BATT_ESTIMATE_REFRESH);
+    }
+}
+
+// Doesn't move an already scheduled refresh, frequent events must not hold it off
+static void battery_estimate_refresh_start(void) {
+    k_work_schedule_for_queue(zmk_display_work_q(), &battery_estimate_refresh,
+                              BATT_ESTIMATE_REFRESH);
+}
+
+#else
+
+static void battery_estimate_refresh_start(void) {}
+
+#endif
+
+void battery_status_update_cb(struct battery_state state) {
+    if (state.source >= BATTERY_SOURCE_COUNT) {
         return;
     }
 
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_BATTERY_ESTIMATE)
+    battery_history_add(state.source, state.level, state.usb_present, k_uptime_get());
+#endif
+    state.minutes_left = battery_minutes_left(state.source);
+
+    // Tracked once per event, independent of how many widgets show it
     bool reconnecting = is_peripheral_reconnecting(state.source, state.level);
     last_battery_levels[state.source] = state.level;
 
@@ -121,24 +221,10 @@ static void set_battery_symbol(lv_obj_t *widget, struct battery_state state) {
 #endif
     }
 
-    lv_obj_t *bar = battery_objects[state.source].bar;
-    if (!bar) return;
+    widget_registry_dispatch(WIDGET_SLOT_BATTERY, &state);
 
-    lv_bar_set_value(bar, state.level, LV_ANIM_ON);
-
-    lv_color_t color = get_battery_color(state.level);
-
-    lv_obj_set_style_border_color(bar, color, LV_PART_MAIN);
-    lv_obj_set_style_bg_color(bar, color, LV_PART_INDICATOR);
-
-    lv_obj_clear_flag(bar, LV_OBJ_FLAG_HIDDEN);
-    lv_obj_move_foreground(bar);
-}
-
-void battery_status_update_cb(struct battery_state state) {
-    struct zmk_widget_dongle_battery_status *widget;
-    SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node) {
-        set_battery_symbol(widget->obj, state);
+    if (state.minutes_left >= 0) {
+        battery_estimate_refresh_start();
     }
 }
 
@@ -198,7 +284,6 @@ int zmk_widget_dongle_battery_status_init(
     lv_obj_t *parent) {
 
     widget->obj = lv_obj_create(parent);
-    lv_obj_set_size(widget->obj, 240, 40);
 
     /* Init styles once */
     if (!styles_initialized) {
@@ -213,35 +298,68 @@ int zmk_widget_dongle_battery_status_init(
         lv_style_set_bg_opa(&style_indic, LV_OPA_COVER);
         lv_style_set_bg_color(&style_indic, lv_color_white());
         lv_style_set_radius(&style_indic, 5);
+
+        lv_style_init(&style_label);
+        lv_style_set_text_font(&style_label,
+                               BATT_ROWS > 1 ? &lv_font_unscii_8 : &lv_font_montserrat_12);
+        lv_style_set_text_color(&style_label, lv_color_white());
+        lv_style_set_bg_color(&style_label, lv_color_black());
+        lv_style_set_bg_opa(&style_label, LV_OPA_70);
+        lv_style_set_pad_hor(&style_label, 2);
+        lv_style_set_radius(&style_label, 3);
     }
 
-    for (int i = 0; i < ZMK_SPLIT_CENTRAL_PERIPHERAL_COUNT + SOURCE_OFFSET; i++) {
+    for (int i = 0; i < BATTERY_SOURCE_COUNT; i++) {
         lv_obj_t *bar = lv_bar_create(widget->obj);
 
         lv_obj_remove_style_all(bar);
         lv_obj_add_style(bar, &style_bg, LV_PART_MAIN);
-        lv_obj_add_style(bar, &style_indIc, LV_PART_INDICATOR);
+        lv_obj_add_style(bar, &style_indic, LV_PART_INDICATOR);
 
-        lv_obj_set_size(bar, BATT_BAR_LENGTH, BATT_BAR_HEIGHT);
+        lv_obj_set_size(bar, lv_pct(BATT_BAR_WIDTH_PCT), BATT_BAR_HEIGHT);
         lv_bar_set_range(bar, BATT_BAR_MIN, BATT_BAR_MAX);
 
         lv_obj_add_flag(bar, LV_OBJ_FLAG_HIDDEN);
-        lv_obj_align(bar, LV_ALIGN_BOTTOM_MID, -60 + (i * 120), -10);
 
-        /* LVGL v9 draw hook */
-        lv_obj_add_event_cb(bar, event_cb, LV_EVENT_DRAW_TASK_ADDED, NULL);
+        // Every bar is its own object, so an update only invalidates that bar
+        int col = i % BATT_COLUMNS;
+        int row = i / BATT_COLUMNS;
+        int y = (2 * row - (BATT_ROWS - 1)) * (BATT_BAR_HEIGHT + BATT_ROW_GAP) / 2;
 
-        battery_objects[i].bar = bar;
-    }
+        lv_obj_align(bar, LV_ALIGN_LEFT_MID, lv_pct(col * 100 / BATT_COLUMNS + BATT_BAR_GAP_PCT), y);
 
-    sys_slist_append(&widgets, &widget->node);
+        lv_obj_t *label = lv_label_create(bar);
+        lv_obj_add_style(label, &style_label, 0);
+        lv_label_set_text_static(label, "");
+        lv_obj_center(label);
+
+        widget->bars[i] = bar;
+        widget->labels[i] = label;
+    }
 
     init_peripheral_tracking();
-    widget_dongle_battery_status_init();
+
+    /* Restore the levels already known when the widget is created again for a page */
+    for (int i = 0; i < BATTERY_SOURCE_COUNT; i++) {
+        if (last_battery_levels[i] >= 0) {
+            apply_battery_level(widget->bars[i], widget->labels[i], last_battery_levels[i],
+                                battery_minutes_left(i), LV_ANIM_OFF);
+        }
+    }
+
+    /* The cached listener state only holds the latest source, the levels above cover all of them */
+    if (widget_registry_add(WIDGET_SLOT_BATTERY, &widget->instance, battery_status_apply)) {
+        widget_dongle_battery_status_init();
+    }
 
     return 0;
 }
 
+void zmk_widget_dongle_battery_status_deinit(
+    struct zmk_widget_dongle_battery_status *widget) {
+    widget_registry_remove(WIDGET_SLOT_BATTERY, &widget->instance);
+}
+
 lv_obj_t *zmk_widget_dongle_battery_status_obj(
     struct zmk_widget_dongle_battery_status *widget) {
     return widget ? widget->obj : NULL;
@@ -8,13 +8,25 @@
 
 #include <lvgl.h>
 #include <zephyr/kernel.h>
+#include <zmk/split/central.h>
+
+#include "registry.h"
+
+#if IS_ENABLED(CONFIG_ZMK_DONGLE_DISPLAY_DONGLE_BATTERY)
+#define SOURCE_OFFSET 1
+#else
+#define SOURCE_OFFSET 0
+#endif
+
+#define BATTERY_SOURCE_COUNT (ZMK_SPLIT_CENTRAL_PERIPHERAL_COUNT + SOURCE_OFFSET)
 
 struct zmk_widget_dongle_battery_status {
-    sys_snode_t node;
+    struct widget_instance instance;
     lv_obj_t *obj;
-    lv_obj_t *value_label;
-    lv_obj_t *bar;
+    lv_obj_t *bars[BATTERY_SOURCE_COUNT];
+    lv_obj_t *labels[BATTERY_SOURCE_COUNT];
 };
 
 int zmk_widget_dongle_battery_status_init(struct zmk_widget_dongle_battery_status *widget, lv_obj_t *parent);
+void zmk_widget_dongle_battery_status_deinit(struct zmk_widget_dongle_battery_status *widget);
 lv_obj_t *zmk_widget_dongle_battery_status_obj(struct zmk_widget_dongle_battery_status *widget);
@@ -1,30 +1,71 @@
 #include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
 #include <lvgl.h>
+#include <zmk/display.h>
 #include "brightness_status.h"
+#include "retained.h"
 
 #define BRIGHTNESS_STATUS_HIDE_DELAY_MS 500
 
+// Mailbox between the brightness logic and the display thread, only the latest value matters.
+static atomic_t brightness_mailbox = ATOMIC_INIT(0);
+
+// Number of label redraws and unhides, read by the ambient light trace replay
+static uint32_t lvgl_updates;
+
+static void brightness_status_work_cb(struct k_work *work)
+{
+    uint8_t brightness = (uint8_t)atomic_get(&brightness_mailbox);
+
+    widget_registry_dispatch(WIDGET_SLOT_BRIGHTNESS, &brightness);
+}
+
+static K_WORK_DEFINE(brightness_status_work, brightness_status_work_cb);
+
+void zmk_widget_brightness_status_post(uint8_t brightness)
+{
+    atomic_set(&brightness_mailbox, brightness);
+
+    // Before the display is up there is nothing to show, the value is simply dropped
+    if (zmk_display_is_initialized())
+    {
+        k_work_submit_to_queue(zmk_display_work_q(), &brightness_status_work);
+    }
+}
+
+static void brightness_status_apply(struct widget_instance *instance, const void *state)
+{
+    zmk_widget_update_brightness_status(CONTAINER_OF(instance, struct zmk_widget_brightness_status, instance),
+                                        *(const uint8_t *)state);
+}
+
 static void brightness_status_timer_cb(lv_timer_t *timer)
 {
     struct zmk_widget_brightness_status *widget = (struct zmk_widget_brightness_status *)lv_timer_get_user_data(timer);
-    if (widget && widget->obj) {
+    if (widget && widget->obj)
+    {
         lv_obj_add_flag(widget->obj, LV_OBJ_FLAG_HIDDEN);
     }
-    lv_timer_del(timer); // Clean up the timer after use
+    lv_timer_pause(timer); // Keep the timer for the next update instead of deleting it
 }
 
 int zmk_widget_update_brightness_status(struct zmk_widget_brightness_status *widget, uint8_t brightness)
 {
+    if (!widget->obj)
+    {
+        return -ENODEV; // The screen has not been created yet
+    }
+
     char brightness_text[8] = {};
     snprintf(brightness_text, sizeof(brightness_text), "%i%%", brightness);
-    lv_label_set_text(widget->label, brightness_text);
 
-    // Unhide the widget
-    lv_obj_clear_flag(widget->obj, LV_OBJ_FLAG_HIDDEN);
+    // Only redraw the label if the value actually changed, and unhide the widget
+    lvgl_updates += retained_label_set_text(widget->label, brightness_text);
+    lvgl_updates += retained_set_hidden(widget->obj, false);
 
-    // Start a one-shot timer to hide the widget after 300ms
-    lv_timer_t * timer = lv_timer_create(brightness_status_timer_cb, BRIGHTNESS_STATUS_HIDE_DELAY_MS, widget);
-    lv_timer_set_repeat_count(timer, 1);
+    // Restart the hide delay, repeated updates just push the hide further out
+    lv_timer_reset(widget->hide_timer);
+    lv_timer_resume(widget->hide_timer);
 
     return 0;
 }
@@ -32,7 +73,6 @@ int zmk_widget_update_brightness_status(struct zmk_widget_brightness_status *wid
 int zmk_widget_brightness_status_init(struct zmk_widget_brightness_status *widget, lv_obj_t *parent)
 {
     widget->obj = lv_obj_create(parent);
-    lv_obj_set_size(widget->obj, 240, 280);
     lv_obj_set_style_bg_color(widget->obj, lv_color_black(), 0);
     lv_obj_set_style_bg_opa(widget->obj, LV_OPA_60, 0);
 
@@ -42,9 +82,20 @@ int zmk_widget_brightness_status_init(struct zmk_widget_brightness_status *widge
     lv_obj_set_style_text_font(widget->label, &lv_font_montserrat_40, 0);
     
     lv_obj_add_flag(widget->obj, LV_OBJ_FLAG_HIDDEN);
+
+    widget->hide_timer = lv_timer_create(brightness_status_timer_cb, BRIGHTNESS_STATUS_HIDE_DELAY_MS, widget);
+    lv_timer_pause(widget->hide_timer);
+
+    // Nothing to apply at creation, the overlay only shows up when the brightness changes
+    widget_registry_add(WIDGET_SLOT_BRIGHTNESS, &widget->instance, brightness_status_apply);
     return 0;
 }
 
+uint32_t zmk_widget_brightness_status_update_count(void)
+{
+    return lvgl_updates;
+}
+
 lv_obj_t *zmk_widget_brightness_status_obj(struct zmk_widget_brightness_status *widget)
 {
     return widget->obj;
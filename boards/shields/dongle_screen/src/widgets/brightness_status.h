@@ -3,13 +3,29 @@
 #include <lvgl.h>
 #include <zephyr/kernel.h>
 
+#include "registry.h"
+
 struct zmk_widget_brightness_status
 {
-    sys_snode_t node;
+    struct widget_instance instance;
     lv_obj_t *obj;
     lv_obj_t *label;
+    lv_timer_t *hide_timer; // Persistent one-shot timer, paused while the widget is hidden
 };
 
 int zmk_widget_brightness_status_init(struct zmk_widget_brightness_status *widget, lv_obj_t *parent);
 int zmk_widget_update_brightness_status(struct zmk_widget_brightness_status *widget, uint8_t brightness);
+
+/**
+ * @brief Hand a new brightness value to the display thread
+ *
+ * Safe to call from any thread. Only the latest value is kept, the widgets are updated
+ * on the display work queue so LVGL is never touched from the caller's context.
+ */
+void zmk_widget_brightness_status_post(uint8_t brightness);
+
+/**
+ * @brief Number of LVGL changes (label text or visibility) the widgets made since boot
+ */
+uint32_t zmk_widget_brightness_status_update_count(void);
 lv_obj_t *zmk_widget_brightness_status_obj(struct zmk_widget_brightness_status *widget);
@@ -9,8 +9,10 @@
 #include <zmk/display.h>
 #include <zmk/event_manager.h>
 #include <zmk/events/hid_indicators_changed.h>
+#include <zmk/hid_indicators.h>
 #include <fonts.h>
 #include "hid_indicators.h"
+#include "retained.h"
 #include <lvgl.h>
 
 // Offsets for each of the lock states.
@@ -26,8 +28,6 @@ struct hid_indicators_state {
     uint8_t hid_indicators;
 };
 
-static sys_slist_t widgets = SYS_SLIST_STATIC_INIT(&widgets);
-
 static void set_hid_indicators(struct zmk_widget_hid_indicators *widget, struct hid_indicators_state state) {
     bool caps = state.hid_indicators & LED_CLCK;
     bool num = state.hid_indicators & LED_NLCK;
@@ -43,40 +43,34 @@ static void set_hid_indicators(struct zmk_widget_hid_indicators *widget, struct
     const char* num_icon_choice = num ? LOCK : UNLOCK;
     const char* scr_icon_choice = scroll ? LOCK : UNLOCK;
 
-    // Set label colors and text
-    lv_obj_set_style_text_font(widget->caps_icon, &icons_lvgl, 0);
-    lv_obj_set_style_text_color(widget->caps_icon, caps_color, 0);
-    lv_label_set_text(widget->caps_icon, cap_icon_choice);
-    
-    lv_obj_set_style_text_color(widget->caps_label, caps_color, 0);
-    lv_label_set_text(widget->caps_label, "CAP");
+    // Only the colors and icons depend on the state, the fonts and label texts are set at init
+    retained_set_text_color(widget->caps_icon, caps_color, LV_PART_MAIN);
+    retained_label_set_text(widget->caps_icon, cap_icon_choice);
+    retained_set_text_color(widget->caps_label, caps_color, LV_PART_MAIN);
 
-    lv_obj_set_style_text_font(widget->num_icon, &icons_lvgl, 0);
-    lv_obj_set_style_text_color(widget->num_icon, num_color, 0);
-    lv_label_set_text(widget->num_icon, num_icon_choice);
-    
-    lv_label_set_text(widget->num_label, "NUM");
-    lv_obj_set_style_text_color(widget->num_label, num_color, 0);
+    retained_set_text_color(widget->num_icon, num_color, LV_PART_MAIN);
+    retained_label_set_text(widget->num_icon, num_icon_choice);
+    retained_set_text_color(widget->num_label, num_color, LV_PART_MAIN);
 
-    lv_obj_set_style_text_font(widget->scroll_icon, &icons_lvgl, 0);
-    lv_obj_set_style_text_color(widget->scroll_icon, scroll_color, 0);
-    lv_label_set_text(widget->scroll_icon, scr_icon_choice);
+    retained_set_text_color(widget->scroll_icon, scroll_color, LV_PART_MAIN);
+    retained_label_set_text(widget->scroll_icon, scr_icon_choice);
+    retained_set_text_color(widget->scroll_label, scroll_color, LV_PART_MAIN);
+}
 
-    lv_label_set_text(widget->scroll_label, "SCR");
-    lv_obj_set_style_text_color(widget->scroll_label, scroll_color, 0);
+static void hid_indicators_apply(struct widget_instance *instance, const void *state) {
+    set_hid_indicators(CONTAINER_OF(instance, struct zmk_widget_hid_indicators, instance),
+                       *(const struct hid_indicators_state *)state);
 }
 
 void hid_indicators_update_cb(struct hid_indicators_state state) {
-    struct zmk_widget_hid_indicators *widget;
-    SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node) {
-        set_hid_indicators(widget, state);
-    }
+    widget_registry_dispatch(WIDGET_SLOT_HID_INDICATORS, &state);
 }
 
 static struct hid_indicators_state hid_indicators_get_state(const zmk_event_t *eh) {
     struct zmk_hid_indicators_changed *ev = as_zmk_hid_indicators_changed(eh);
     return (struct hid_indicators_state){
-        .hid_indicators = ev->indicators,
+        // Without an event (widget creation) read the indicators of the active profile
+        .hid_indicators = ev ? ev->indicators : zmk_hid_indicators_get_current_profile(),
     };
 }
 
@@ -88,7 +82,6 @@ ZMK_SUBSCRIPTION(widget_hid_indicators, zmk_hid_indicators_changed);
 int zmk_widget_hid_indicators_init(struct zmk_widget_hid_indicators *widget, lv_obj_t *parent) {
     // Create the Main Container
     widget->cont = lv_obj_create(parent);
-    lv_obj_set_size(widget->cont, 80, 80);
     lv_obj_set_style_border_width(widget->cont, 0, 0);
     lv_obj_set_style_pad_all(widget->cont, 0, 0);
     lv_obj_set_style_bg_opa(widget->cont, LV_OPA_TRANSP, 0);
@@ -99,30 +92,39 @@ int zmk_widget_hid_indicators_init(struct zmk_widget_hid_indicators *widget, lv_
     widget->caps_icon = lv_label_create(widget->cont);
     lv_obj_align(widget->caps_icon, LV_ALIGN_TOP_LEFT, 60, 0);
     lv_obj_align(widget->caps_label, LV_ALIGN_TOP_LEFT, 0, 3);
+    lv_obj_set_style_text_font(widget->caps_icon, &icons_lvgl, 0);
+    lv_label_set_text(widget->caps_label, "CAP");
 
     // Setup the NUM Lock Icon and Label
     widget->num_label = lv_label_create(widget->cont);
     widget->num_icon = lv_label_create(widget->cont);
     lv_obj_align(widget->num_icon, LV_ALIGN_TOP_LEFT, 60, 25);
     lv_obj_align(widget->num_label, LV_ALIGN_TOP_LEFT, 0, 28);
+    lv_obj_set_style_text_font(widget->num_icon, &icons_lvgl, 0);
+    lv_label_set_text(widget->num_label, "NUM");
 
     // Setup the SCROLL Lock Icon and Label
     widget->scroll_label = lv_label_create(widget->cont);
     widget->scroll_icon = lv_label_create(widget->cont);
     lv_obj_align(widget->scroll_icon, LV_ALIGN_TOP_LEFT, 60, 50);
     lv_obj_align(widget->scroll_label, LV_ALIGN_TOP_LEFT, 0, 53);
-
-    sys_slist_append(&widgets, &widget->node);
-
-    widget_hid_indicators_init();
+    lv_obj_set_style_text_font(widget->scroll_icon, &icons_lvgl, 0);
+    lv_label_set_text(widget->scroll_label, "SCR");
 
     // Initialize with all inactive
     struct hid_indicators_state initial = {0};
     set_hid_indicators(widget, initial);
 
+    WIDGET_REGISTRY_ADD(WIDGET_SLOT_HID_INDICATORS, &widget->instance, hid_indicators_apply,
+                        widget_hid_indicators);
+
     return 0;
 }
 
+void zmk_widget_hid_indicators_deinit(struct zmk_widget_hid_indicators *widget) {
+    widget_registry_remove(WIDGET_SLOT_HID_INDICATORS, &widget->instance);
+}
+
 lv_obj_t *zmk_widget_hid_indicators_obj(struct zmk_widget_hid_indicators *widget) {
     return widget->cont;
 }
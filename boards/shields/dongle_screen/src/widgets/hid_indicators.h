@@ -9,6 +9,8 @@
 #include <lvgl.h>
 #include <zephyr/kernel.h>
 
+#include "registry.h"
+
 struct zmk_widget_hid_indicators {
     lv_obj_t *cont;
     lv_obj_t *caps_label;
@@ -17,8 +19,9 @@ struct zmk_widget_hid_indicators {
     lv_obj_t *num_icon;
     lv_obj_t *scroll_label;
     lv_obj_t *scroll_icon;
-    sys_snode_t node;
+    struct widget_instance instance;
 };
 
 int zmk_widget_hid_indicators_init(struct zmk_widget_hid_indicators *widget, lv_obj_t *parent);
+void zmk_widget_hid_indicators_deinit(struct zmk_widget_hid_indicators *widget);
 lv_obj_t *zmk_widget_hid_indicators_obj(struct zmk_widget_hid_indicators *widget);
@@ -1,121 +1,224 @@
 #include "layer_roller.h"
 
 #include <ctype.h>
+#include <stdio.h>
+#include <string.h>
 #include <zmk/display.h>
 #include <zmk/events/layer_state_changed.h>
 #include <zmk/event_manager.h>
 #include <zmk/keymap.h>
 
 #include <fonts.h>
+#include "layer_styles.h"
+#include "retained.h"
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 
-static char layer_names_buffer[256] = {0}; // Buffer for concatenated layer names
+#if defined(CONFIG_ZMK_KEYMAP_LAYER_NAME_MAX_LEN)
+#define LAYER_NAME_MAX CONFIG_ZMK_KEYMAP_LAYER_NAME_MAX_LEN
+#else
+#define LAYER_NAME_MAX 20
+#endif
 
-static int layer_select_id[6] = {2, 4, 3, 1, 0}; // Select order of layers.
+// Bytes of a layer icon shown in the roller, followed by a space. Longer icons are cut at the
+// last whole UTF-8 character that fits.
+#define LAYER_ICON_MAX 7
 
-static int layer_display_order[6] = {4, 3, 0, 2, 1}; // Display order of layers.
+// Every layer takes at most the icon, LAYER_NAME_MAX characters and the newline (or terminator)
+static char layer_names_buffer[ZMK_KEYMAP_LAYERS_LEN * (LAYER_ICON_MAX + 1 + LAYER_NAME_MAX + 1)];
 
-static sys_slist_t widgets = SYS_SLIST_STATIC_INIT(&widgets);
+// Roller row per layer id, filled while the options are built. Layers that are not in the
+// keymap have no row.
+#define LAYER_ROW_NONE 0xFF
+static uint8_t layer_rows[ZMK_KEYMAP_LAYERS_LEN];
 
 struct layer_roller_state {
     uint8_t index;
 };
 
 static void layer_roller_set_sel(lv_obj_t *roller, struct layer_roller_state state) {
-    if (state.index == 1) {
-        lv_obj_set_style_text_color(roller, lv_palette_main(LV_PALETTE_ORANGE), LV_PART_SELECTED);
-    } else if (state.index == 4) {
-        lv_obj_set_style_text_color(roller, lv_palette_main(LV_PALETTE_GREEN), LV_PART_SELECTED);
-    } else {
-        lv_obj_set_style_text_color(roller, lv_color_white(), LV_PART_SELECTED);
+    if (state.index >= ZMK_KEYMAP_LAYERS_LEN || layer_rows[state.index] == LAYER_ROW_NONE) {
+        return;
+    }
+
+    const struct layer_style *style = layer_style_get(state.index);
+
+    retained_set_text_color(roller, style->color, LV_PART_SELECTED);
+    retained_set_text_font(roller, style->font ? style->font : &lv_font_montserrat_40,
+                           LV_PART_SELECTED);
+    // LVGL restarts the scroll animation even for the row already selected
+    if (lv_roller_get_selected(roller) != layer_rows[state.index]) {
+        lv_roller_set_selected(roller, layer_rows[state.index], LV_ANIM_ON);
     }
-    lv_roller_set_selected(roller, layer_select_id[state.index], LV_ANIM_ON);
 }
 
-static void layer_roller_update_cb(struct layer_roller_state state) {
-    struct zmk_widget_layer_roller *widget;
-    SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node) {
-        layer_roller_set_sel(widget->obj, state);
+// Bytes of the UTF-8 sequence starting with @p lead, a stray continuation byte counts as one
+static int utf8_sequence_len(unsigned char lead) {
+    if (lead >= 0xF0) {
+        return 4;
     }
+    if (lead >= 0xE0) {
+        return 3;
+    }
+    if (lead >= 0xC0) {
+        return 2;
+    }
+    return 1;
 }
 
-static struct layer_roller_state layer_roller_get_state(const zmk_event_t *eh) {
-    uint8_t index = zmk_keymap_highest_layer_active();
-    return (struct layer_roller_state){
-        .index = index,
-    };
+// Copy whole characters of @p icon, at most LAYER_ICON_MAX bytes
+static char *layer_roller_copy_icon(char *ptr, const char *icon) {
+    size_t n = 0;
+
+    while (icon[n]) {
+        size_t len = utf8_sequence_len(icon[n]);
+
+        // Stop before a character that doesn't fit or is cut off at the end of the string
+        if (n + len > LAYER_ICON_MAX || strnlen(&icon[n], len) < len) {
+            break;
+        }
+        memcpy(ptr, &icon[n], len);
+        ptr += len;
+        n += len;
+    }
+
+    return ptr;
 }
 
-ZMK_DISPLAY_WIDGET_LISTENER(widget_layer_roller, struct layer_roller_state, layer_roller_update_cb,
-                            layer_roller_get_state)
-ZMK_SUBSCRIPTION(widget_layer_roller, zmk_layer_state_changed);
+// Build the roller options in keymap order in one pass, and record the row of every layer
+static void layer_roller_build_options(void) {
+    char *ptr = layer_names_buffer;
+    char *end = layer_names_buffer + sizeof(layer_names_buffer);
+    uint8_t row = 0;
 
-static void mask_event_cb(lv_event_t * e)
-{
-    lv_event_code_t code = lv_event_get_code(e);
-    lv_obj_t * obj = lv_event_get_target(e);
+    memset(layer_rows, LAYER_ROW_NONE, sizeof(layer_rows));
 
-    static int16_t mask_top_id = -1;
-    static int16_t mask_bottom_id = -1;
+    for (int i = 0; i < ZMK_KEYMAP_LAYERS_LEN; i++) {
+        zmk_keymap_layer_id_t id = zmk_keymap_layer_index_to_id(i);
+        if (id == ZMK_KEYMAP_LAYER_ID_INVAL || id >= ZMK_KEYMAP_LAYERS_LEN) {
+            continue;
+        }
 
-    if(code == LV_EVENT_COVER_CHECK) {
-        lv_event_set_cover_res(e, LV_COVER_RES_MASKED);
+        if (row > 0) {
+            *ptr++ = '\n';
+        }
 
+        const char *icon = layer_style_get(id)->icon;
+        if (icon && *icon) {
+            ptr = layer_roller_copy_icon(ptr, icon);
+            *ptr++ = ' ';
+        }
+
+        const char *layer_name = zmk_keymap_layer_name(id);
+        if (layer_name && *layer_name) {
+            // Copy up to LAYER_NAME_MAX characters, there is always room for them
+            for (int n = 0; n < LAYER_NAME_MAX && layer_name[n]; n++) {
+#if IS_ENABLED(CONFIG_LAYER_ROLLER_ALL_CAPS)
+                *ptr++ = toupper((unsigned char)layer_name[n]);
+#else
+                *ptr++ = layer_name[n];
+#endif
+            }
+        } else {
+            // If a layer doesn't have a name, just use the layer number
+            ptr += snprintf(ptr, end - ptr, "%d", id);
+        }
+
+        layer_rows[id] = row++;
     }
-    else if(code == LV_EVENT_DRAW_MAIN_BEGIN) {
-        /* add mask */
-        const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_SELECTED);
-        lv_coord_t line_space = lv_obj_get_style_text_line_space(obj, LV_PART_MAIN);
-        lv_coord_t font_h = lv_font_get_line_height(font);
 
-        lv_area_t roller_coords;
-        lv_obj_get_coords(obj, &roller_coords);
+    *ptr = '\0';
+}
 
-        lv_area_t rect_area;
-        rect_area.x1 = roller_coords.x1;
-        rect_area.x2 = roller_coords.x2;
-        rect_area.y1 = roller_coords.y1;
-        // rect_area.y2 = roller_coords.y1 + (lv_obj_get_height(obj) - font_h - line_space) / 2;
-        rect_area.y2 = roller_coords.y1 + (lv_obj_get_height(obj) - font_h) / 2;
+static void layer_roller_apply(struct widget_instance *instance, const void *state) {
+    layer_roller_set_sel(CONTAINER_OF(instance, struct zmk_widget_layer_roller, instance)->obj,
+                         *(const struct layer_roller_state *)state);
+}
 
-        lv_draw_sw_mask_fade_param_t * fade_mask_top = lv_mem_buf_get(sizeof(lv_draw_mask_fade_param_t));
-        lv_draw_mask_fade_init(fade_mask_top, &rect_area, LV_OPA_TRANSP, rect_area.y1, LV_OPA_COVER, rect_area.y2);
-        mask_top_id = lv_draw_mask_add(fade_mask_top, NULL);
+static void layer_roller_update_cb(struct layer_roller_state state) {
+    widget_registry_dispatch(WIDGET_SLOT_LAYER_ROLLER, &state);
+}
 
-        rect_area.y1 = rect_area.y2 + font_h + line_space - 1;
-        rect_area.y2 = roller_coords.y2;
+static struct layer_roller_state layer_roller_get_state(const zmk_event_t *eh) {
+    uint8_t index = zmk_keymap_highest_layer_active();
+    return (struct layer_roller_state){
+        .index = index,
+    };
+}
 
-        lv_draw_sw_mask_fade_param_t * fade_mask_bottom = lv_mem_buf_get(sizeof(lv_draw_mask_fade_param_t));
-        lv_draw_mask_fade_init(fade_mask_bottom, &rect_area, LV_OPA_COVER, rect_area.y1, LV_OPA_TRANSP, rect_area.y2);
-        mask_bottom_id = lv_draw_mask_add(fade_mask_bottom, NULL);
+ZMK_DISPLAY_WIDGET_LISTENER(widget_layer_roller, struct layer_roller_state, layer_roller_update_cb,
+                            layer_roller_get_state)
+ZMK_SUBSCRIPTION(widget_layer_roller, zmk_layer_state_changed);
 
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_LAYER_ROLLER_FADE)
+
+// Share of the roller height covered by each fade, the middle row stays clear
+#define LAYER_ROLLER_FADE_HEIGHT_PCT 35
+
+static lv_style_t style_fade_top;
+static lv_style_t style_fade_bottom;
+
+// Static gradient overlays towards the roller background instead of draw masks. The styles are
+// set up once and the two overlay objects are created with the widget, scrolling the roller
+// doesn't create objects or styles. LVGL's renderer still allocates its own draw tasks and
+// gradient buffers per frame, that isn't measured here.
+static void layer_roller_add_fade(lv_obj_t *roller) {
+    static bool fade_styles_initialized = false;
+    if (!fade_styles_initialized) {
+        fade_styles_initialized = true;
+
+        lv_style_init(&style_fade_top);
+        lv_style_set_bg_opa(&style_fade_top, LV_OPA_COVER);
+        lv_style_set_bg_color(&style_fade_top, lv_color_black());
+        lv_style_set_bg_grad_color(&style_fade_top, lv_color_black());
+        lv_style_set_bg_grad_dir(&style_fade_top, LV_GRAD_DIR_VER);
+        lv_style_set_bg_main_opa(&style_fade_top, LV_OPA_COVER);
+        lv_style_set_bg_grad_opa(&style_fade_top, LV_OPA_TRANSP);
+        lv_style_set_border_width(&style_fade_top, 0);
+        lv_style_set_radius(&style_fade_top, 0);
+
+        lv_style_init(&style_fade_bottom);
+        lv_style_set_bg_opa(&style_fade_bottom, LV_OPA_COVER);
+        lv_style_set_bg_color(&style_fade_bottom, lv_color_black());
+        lv_style_set_bg_grad_color(&style_fade_bottom, lv_color_black());
+        lv_style_set_bg_grad_dir(&style_fade_bottom, LV_GRAD_DIR_VER);
+        lv_style_set_bg_main_opa(&style_fade_bottom, LV_OPA_TRANSP);
+        lv_style_set_bg_grad_opa(&style_fade_bottom, LV_OPA_COVER);
+        lv_style_set_border_width(&style_fade_bottom, 0);
+        lv_style_set_radius(&style_fade_bottom, 0);
     }
-    else if(code == LV_EVENT_DRAW_POST_END) {
-        lv_draw_mask_fade_param_t * fade_mask_top = lv_draw_mask_remove_id(mask_top_id);
-        lv_draw_mask_fade_param_t * fade_mask_bottom = lv_draw_mask_remove_id(mask_bottom_id);
-        lv_draw_mask_free_param(fade_mask_top);
-        lv_draw_mask_free_param(fade_mask_bottom);
-        lv_mem_buf_release(fade_mask_top);
-        lv_mem_buf_release(fade_mask_bottom);
-        mask_top_id = -1;
-        mask_bottom_id = -1;
+
+    lv_obj_t *fades[2] = {lv_obj_create(roller), lv_obj_create(roller)};
+
+    for (int i = 0; i < 2; i++) {
+        lv_obj_remove_style_all(fades[i]);
+        lv_obj_add_style(fades[i], i == 0 ? &style_fade_top : &style_fade_bottom, 0);
+        // Sized relative to the roller, so the overlays follow the tile the layout assigns
+        lv_obj_set_size(fades[i], lv_pct(100), lv_pct(LAYER_ROLLER_FADE_HEIGHT_PCT));
+        lv_obj_align(fades[i], i == 0 ? LV_ALIGN_TOP_MID : LV_ALIGN_BOTTOM_MID, 0, 0);
+        lv_obj_add_flag(fades[i], LV_OBJ_FLAG_FLOATING | LV_OBJ_FLAG_IGNORE_LAYOUT);
+        lv_obj_remove_flag(fades[i], LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
     }
 }
 
+#endif
+
 int zmk_widget_layer_roller_init(struct zmk_widget_layer_roller *widget, lv_obj_t *parent) {
     widget->obj = lv_roller_create(parent);
-    lv_obj_set_size(widget->obj, 240, 80);
 
     static lv_style_t style;
-    lv_style_init(&style);
-    lv_style_set_bg_color(&style, lv_color_black());
-    lv_style_set_text_color(&style, lv_color_white());
-    lv_style_set_text_line_space(&style, 0);
-    //lv_style_set_border_width(&style, 1);
-    //lv_style_set_border_color(&style, lv_palette_main(LV_PALETTE_LIGHT_BLUE));
-    lv_style_set_pad_all(&style, 0);
+    static bool style_initialized = false;
+    if (!style_initialized) {
+        style_initialized = true;
+        lv_style_init(&style);
+        lv_style_set_bg_color(&style, lv_color_black());
+        lv_style_set_text_color(&style, lv_color_white());
+        lv_style_set_text_line_space(&style, 0);
+        //lv_style_set_border_width(&style, 1);
+        //lv_style_set_border_color(&style, lv_palette_main(LV_PALETTE_LIGHT_BLUE));
+        lv_style_set_pad_all(&style, 0);
+    }
     lv_obj_add_style(widget->obj, &style, 0);
 
     // Set the background opacity, text size, and color for the selected layer.
@@ -128,56 +231,25 @@ int zmk_widget_layer_roller_init(struct zmk_widget_layer_roller *widget, lv_obj_
     lv_obj_set_style_text_font(widget->obj, &lv_font_montserrat_32, LV_PART_MAIN);
     lv_obj_set_style_text_color(widget->obj, lv_palette_darken(LV_PALETTE_GREY,4), LV_PART_MAIN);
 
-    layer_names_buffer[0] = '\0';
-    char *ptr = layer_names_buffer;
-
-    for (int i = 0; i < ZMK_KEYMAP_LAYERS_LEN; i++) {
-        const char *layer_name = zmk_keymap_layer_name(zmk_keymap_layer_index_to_id(layer_display_order[i]));
-        if (layer_name) {
-
-            // For each layer name after the first layer name and a newline.
-            if (i > 0) {
-                strcat(ptr, "\n");
-                ptr += strlen(ptr);
-            }
-
-            if (layer_name && *layer_name) { //is both valid and points to a non-empty string
-                // If the layer names should be all caps, modify them to be so.
-                #if IS_ENABLED(CONFIG_LAYER_ROLLER_ALL_CAPS)
-                while (*layer_name) {
-                    *ptr = toupper((unsigned char)*layer_name);
-                    ptr++;
-                    layer_name++;
-                }
-                *ptr = '\0';
-                // Otherwise, just add the layer name directly to the buffer.
-                #else
-                strcat(ptr, layer_name);
-                ptr += strlen(layer_name);
-            #endif
-            // If a layer doesn't have a name, just use the layer number.  Supports up to 99 layers.
-            } else {
-                char index_str[2];
-                snprintf(index_str, sizeof(index_str), "%d", i);
-                strcat(ptr, index_str);
-                ptr += strlen(index_str);
-            }
-        }
-    }
-
+    layer_styles_init();
+    layer_roller_build_options();
     lv_roller_set_options(widget->obj, layer_names_buffer, LV_ROLLER_MODE_NORMAL);
     lv_roller_set_visible_row_count(widget->obj, 3);
     
-    //lv_obj_add_event_cb(widget->obj, mask_event_cb, LV_EVENT_ALL, NULL);
-    
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_LAYER_ROLLER_FADE)
+    layer_roller_add_fade(widget->obj);
+#endif
+
     lv_obj_set_style_anim_time(widget->obj, 400, 0);
     
-    sys_slist_append(&widgets, &widget->node);
-    
-    widget_layer_roller_init();
+    WIDGET_REGISTRY_ADD(WIDGET_SLOT_LAYER_ROLLER, &widget->instance, layer_roller_apply, widget_layer_roller);
     return 0;
 }
 
+void zmk_widget_layer_roller_deinit(struct zmk_widget_layer_roller *widget) {
+    widget_registry_remove(WIDGET_SLOT_LAYER_ROLLER, &widget->instance);
+}
+
 lv_obj_t *zmk_widget_layer_roller_obj(struct zmk_widget_layer_roller *widget) {
     return widget->obj;
 }
@@ -3,10 +3,13 @@
 #include <lvgl.h>
 #include <zephyr/kernel.h>
 
+#include "registry.h"
+
 struct zmk_widget_layer_roller {
-    sys_snode_t node;
+    struct widget_instance instance;
     lv_obj_t *obj;
 };
 
 int zmk_widget_layer_roller_init(struct zmk_widget_layer_roller *widget, lv_obj_t *parent);
+void zmk_widget_layer_roller_deinit(struct zmk_widget_layer_roller *widget);
 lv_obj_t *zmk_widget_layer_roller_obj(struct zmk_widget_layer_roller *widget);
\ No newline at end of file
@@ -15,6 +15,9 @@ LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 #include <zmk/endpoints.h>
 #include <zmk/keymap.h>
 
+#include "layer_styles.h"
+#include "retained.h"
+
 static sys_slist_t widgets = SYS_SLIST_STATIC_INIT(&widgets);
 
 struct layer_status_state
@@ -25,30 +28,22 @@ struct layer_status_state
 
 static void set_layer_symbol(lv_obj_t *label, struct layer_status_state state)
 {
+    const struct layer_style *style = layer_style_get(state.index);
+    const char *icon = style->icon ? style->icon : "";
+    char text[32] = {};
+
     if (state.label == NULL)
     {
-        char text[7] = {};
-
-        sprintf(text, "%i", state.index);
-
-        lv_label_set_text(label, text);
+        snprintf(text, sizeof(text), "%s%s%i", icon, *icon ? " " : "", state.index);
     }
     else
     {
-
-        char text[16] = {};
-        if (strcmp(state.label,"Orange") == 0) {
-            const char *layer_color = "ffa500";
-            snprintf(text, sizeof(text), "#%s %s", layer_color, state.label);
-        } else if (strcmp(state.label,"Green") == 0) {
-            const char *layer_color = "00ff00";
-            snprintf(text, sizeof(text), "#%s %s", layer_color, state.label);
-        } else {
-            snprintf(text, sizeof(text), "%s", state.label);
-        }
-        lv_label_set_recolor(label, true);
-        lv_label_set_text(label, text);
+        snprintf(text, sizeof(text), "%s%s%s", icon, *icon ? " " : "", state.label);
     }
+
+    retained_set_text_color(label, style->color, LV_PART_MAIN);
+    retained_set_text_font(label, style->font ? style->font : &lv_font_montserrat_40, LV_PART_MAIN);
+    retained_label_set_text(label, text);
 }
 
 static void layer_status_update_cb(struct layer_status_state state)
@@ -76,6 +71,8 @@ int zmk_widget_layer_status_init(struct zmk_widget_layer_status *widget, lv_obj_
 
     lv_obj_set_style_text_font(widget->obj, &lv_font_montserrat_40, 0);
 
+    layer_styles_init();
+
     sys_slist_append(&widgets, &widget->node);
 
     widget_layer_status_init();
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/devicetree.h>
+#include <zephyr/kernel.h>
+#include <zmk/keymap.h>
+
+#include "layer_styles.h"
+
+#define DT_DRV_COMPAT zmk_dongle_screen_layer_styles
+
+static struct layer_style layer_styles[ZMK_KEYMAP_LAYERS_LEN];
+
+static const struct layer_style default_style = {
+    .color = LV_COLOR_MAKE(0xff, 0xff, 0xff),
+    .font = NULL,
+    .icon = NULL,
+};
+
+#define LAYER_STYLE_FONT(node)                                                                     \
+    COND_CODE_1(DT_NODE_HAS_PROP(node, font),                                                      \
+                (&UTIL_CAT(lv_font_, DT_STRING_TOKEN(node, font))), (NULL))
+
+#define LAYER_STYLE_APPLY(node)                                                                    \
+    BUILD_ASSERT(DT_PROP(node, layer) < ZMK_KEYMAP_LAYERS_LEN,                                     \
+                 "Layer style for a layer that is not in the keymap");                             \
+    layer_styles[DT_PROP(node, layer)] = (struct layer_style){                                     \
+        .color = lv_color_hex(DT_PROP(node, color)),                                               \
+        .font = LAYER_STYLE_FONT(node),                                                            \
+        .icon = DT_PROP_OR(node, icon, NULL),                                                      \
+    };
+
+#define LAYER_STYLES_INST(n) DT_INST_FOREACH_CHILD(n, LAYER_STYLE_APPLY)
+
+void layer_styles_init(void)
+{
+    static bool initialized = false;
+    if (initialized)
+    {
+        return;
+    }
+    initialized = true;
+
+    for (int i = 0; i < ZMK_KEYMAP_LAYERS_LEN; i++)
+    {
+        layer_styles[i] = default_style;
+    }
+
+    DT_INST_FOREACH_STATUS_OKAY(LAYER_STYLES_INST)
+}
+
+const struct layer_style *layer_style_get(uint8_t layer_id)
+{
+    if (layer_id >= ZMK_KEYMAP_LAYERS_LEN)
+    {
+        return &default_style;
+    }
+    return &layer_styles[layer_id];
+}
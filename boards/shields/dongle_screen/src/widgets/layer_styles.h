@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <lvgl.h>
+
+/**
+ * @brief Text style of one layer, from the "zmk,dongle-screen-layer-styles" devicetree nodes
+ */
+struct layer_style
+{
+    lv_color_t color;
+    const lv_font_t *font; // NULL: the default font of the widget
+    const char *icon;      // NULL: no icon
+};
+
+/**
+ * @brief Resolve the devicetree layer styles into the table indexed by layer id
+ *
+ * Only does work on the first call, every widget showing layers calls it from its init.
+ */
+void layer_styles_init(void);
+
+/**
+ * @brief Style of a layer, a plain table lookup
+ *
+ * @param layer_id Layer id, out of range ids get the default style
+ */
+const struct layer_style *layer_style_get(uint8_t layer_id);
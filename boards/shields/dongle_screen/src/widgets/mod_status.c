@@ -1,15 +1,52 @@
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #include <zmk/hid.h>
+#include <zmk/display.h>
+#include <zmk/event_manager.h>
+#include <zmk/events/keycode_state_changed.h>
 #include <lvgl.h>
 #include "mod_status.h"
 #include <fonts.h> // <-- Wichtig für LV_FONT_DECLARE
 
 LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 
-static void update_mod_status(struct zmk_widget_mod_status *widget)
+struct mod_status_state
 {
-    uint8_t mods = zmk_hid_get_keyboard_report()->body.modifiers;
+    zmk_mod_flags_t mods;
+};
+
+static struct mod_status_state get_state(const zmk_event_t *eh)
+{
+    zmk_mod_flags_t mods = zmk_hid_get_explicit_mods();
+    const struct zmk_keycode_state_changed *ev = as_zmk_keycode_state_changed(eh);
+
+    if (ev)
+    {
+        // The explicit mods already include this event, subscriptions run sorted by name and
+        // ZMK's hid_listener comes before widget_mod_status. Implicit modifiers (like the shift
+        // of LS(A)) are held for as long as their key.
+        if (ev->state)
+        {
+            mods |= ev->implicit_modifiers;
+        }
+    }
+    else
+    {
+        mods = zmk_hid_get_keyboard_report()->body.modifiers;
+    }
+
+    return (struct mod_status_state){.mods = mods};
+}
+
+static void set_mod_status(struct zmk_widget_mod_status *widget, zmk_mod_flags_t mods)
+{
+    if (widget->last_mods_valid && mods == widget->last_mods)
+    {
+        return; // Most key events don't touch the modifiers
+    }
+    widget->last_mods = mods;
+    widget->last_mods_valid = true;
+
     char text[32] = "";
     int idx = 0;
 
@@ -43,31 +80,40 @@ static void update_mod_status(struct zmk_widget_mod_status *widget)
     lv_label_set_text(widget->label, idx ? text : "");
 }
 
-static void mod_status_timer_cb(struct k_timer *timer)
+static void mod_status_apply(struct widget_instance *instance, const void *state)
+{
+    set_mod_status(CONTAINER_OF(instance, struct zmk_widget_mod_status, instance),
+                   ((const struct mod_status_state *)state)->mods);
+}
+
+static void mod_status_update_cb(struct mod_status_state state)
 {
-    struct zmk_widget_mod_status *widget = k_timer_user_data_get(timer);
-    update_mod_status(widget);
+    widget_registry_dispatch(WIDGET_SLOT_MODIFIERS, &state);
 }
 
-static struct k_timer mod_status_timer;
+ZMK_DISPLAY_WIDGET_LISTENER(widget_mod_status, struct mod_status_state, mod_status_update_cb, get_state)
+ZMK_SUBSCRIPTION(widget_mod_status, zmk_keycode_state_changed);
 
 int zmk_widget_mod_status_init(struct zmk_widget_mod_status *widget, lv_obj_t *parent)
 {
     widget->obj = lv_obj_create(parent);
-    lv_obj_set_size(widget->obj, 240, 40);
 
     widget->label = lv_label_create(widget->obj);
     lv_obj_align(widget->label, LV_ALIGN_CENTER, 0, 0);
     lv_label_set_text(widget->label, "-");
     lv_obj_set_style_text_font(widget->label, &NerdFonts_Regular_40, 0); // <-- NerdFont setzen
+    widget->last_mods_valid = false;
 
-    k_timer_init(&mod_status_timer, mod_status_timer_cb, NULL);
-    k_timer_user_data_set(&mod_status_timer, widget);
-    k_timer_start(&mod_status_timer, K_MSEC(100), K_MSEC(100));
+    WIDGET_REGISTRY_ADD(WIDGET_SLOT_MODIFIERS, &widget->instance, mod_status_apply, widget_mod_status);
 
     return 0;
 }
 
+void zmk_widget_mod_status_deinit(struct zmk_widget_mod_status *widget)
+{
+    widget_registry_remove(WIDGET_SLOT_MODIFIERS, &widget->instance);
+}
+
 lv_obj_t *zmk_widget_mod_status_obj(struct zmk_widget_mod_status *widget)
 {
     return widget->obj;
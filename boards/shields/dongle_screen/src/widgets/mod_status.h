@@ -2,13 +2,19 @@
 
 #include <lvgl.h>
 #include <zmk/display.h>
+#include <zmk/keys.h>
+
+#include "registry.h"
 
 struct zmk_widget_mod_status
 {
-    sys_snode_t node;
+    struct widget_instance instance;
     lv_obj_t *obj;
     lv_obj_t *label;
+    zmk_mod_flags_t last_mods; // Modifier mask shown on the label
+    bool last_mods_valid;      // False until the first update
 };
 
 int zmk_widget_mod_status_init(struct zmk_widget_mod_status *widget, lv_obj_t *parent);
+void zmk_widget_mod_status_deinit(struct zmk_widget_mod_status *widget);
 lv_obj_t *zmk_widget_mod_status_obj(struct zmk_widget_mod_status *widget);
\ No newline at end of file
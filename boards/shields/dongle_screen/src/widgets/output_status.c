@@ -20,8 +20,7 @@ LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 #include <lvgl.h>
 
 #include "output_status.h"
-
-static sys_slist_t widgets = SYS_SLIST_STATIC_INIT(&widgets);
+#include "retained.h"
 
 struct output_status_state
 {
@@ -53,29 +52,31 @@ static void set_status_symbol(struct zmk_widget_output_status *widget, struct ou
     // Create the BLE Label text based on the active profile index.
     char ble_text[12];
     snprintf(ble_text, sizeof(ble_text), "%s BLE %d", LV_SYMBOL_BLUETOOTH, state.active_profile_index + 1);
-    lv_label_set_text(widget->ble_label, ble_text);
+    retained_label_set_text(widget->ble_label, ble_text);
 
     // Highlight the endpoint being used based on the color choices above, and set the inavtice endpoint a dark grey.
     switch (state.selected_endpoint.transport)
     {
     case ZMK_TRANSPORT_USB:
-        lv_obj_set_style_text_color(widget->usb_label, usb_color, 0);
-        lv_obj_set_style_text_color(widget->ble_label, inactive_color, 0);
+        retained_set_text_color(widget->usb_label, usb_color, LV_PART_MAIN);
+        retained_set_text_color(widget->ble_label, inactive_color, LV_PART_MAIN);
         break;
     case ZMK_TRANSPORT_BLE:
-        lv_obj_set_style_text_color(widget->usb_label, inactive_color, 0);
-        lv_obj_set_style_text_color(widget->ble_label, ble_color, 0);
+        retained_set_text_color(widget->usb_label, inactive_color, LV_PART_MAIN);
+        retained_set_text_color(widget->ble_label, ble_color, LV_PART_MAIN);
         break;
     }
 }
 
+static void output_status_apply(struct widget_instance *instance, const void *state)
+{
+    set_status_symbol(CONTAINER_OF(instance, struct zmk_widget_output_status, instance),
+                      *(const struct output_status_state *)state);
+}
+
 static void output_status_update_cb(struct output_status_state state)
 {
-    struct zmk_widget_output_status *widget;
-    SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node)
-    {
-        set_status_symbol(widget, state);
-    }
+    widget_registry_dispatch(WIDGET_SLOT_OUTPUT, &state);
 }
 
 ZMK_DISPLAY_WIDGET_LISTENER(widget_output_status, struct output_status_state,
@@ -88,7 +89,6 @@ ZMK_SUBSCRIPTION(widget_output_status, zmk_usb_conn_state_changed);
 int zmk_widget_output_status_init(struct zmk_widget_output_status *widget, lv_obj_t *parent)
 {
     widget->obj = lv_obj_create(parent);
-    lv_obj_set_size(widget->obj, 240, 50);
 
     // Setup the USB Label, since the label text is static assign it here.
     widget->usb_label = lv_label_create(widget->obj);
@@ -101,12 +101,15 @@ int zmk_widget_output_status_init(struct zmk_widget_output_status *widget, lv_ob
     lv_obj_align(widget->ble_label, LV_ALIGN_TOP_RIGHT, 0, 20);
     lv_obj_set_style_text_align(widget->ble_label, LV_TEXT_ALIGN_RIGHT, 0);
 
-    sys_slist_append(&widgets, &widget->node);
-
-    widget_output_status_init();
+    WIDGET_REGISTRY_ADD(WIDGET_SLOT_OUTPUT, &widget->instance, output_status_apply, widget_output_status);
     return 0;
 }
 
+void zmk_widget_output_status_deinit(struct zmk_widget_output_status *widget)
+{
+    widget_registry_remove(WIDGET_SLOT_OUTPUT, &widget->instance);
+}
+
 lv_obj_t *zmk_widget_output_status_obj(struct zmk_widget_output_status *widget)
 {
     return widget->obj;
@@ -9,14 +9,17 @@
 #include <lvgl.h>
 #include <zephyr/kernel.h>
 
+#include "registry.h"
+
 // output_status.h
 struct zmk_widget_output_status
 {
     lv_obj_t *obj;
     lv_obj_t *usb_label;
     lv_obj_t *ble_label;
-    sys_snode_t node;
+    struct widget_instance instance;
 };
 
 int zmk_widget_output_status_init(struct zmk_widget_output_status *widget, lv_obj_t *parent);
+void zmk_widget_output_status_deinit(struct zmk_widget_output_status *widget);
 lv_obj_t *zmk_widget_output_status_obj(struct zmk_widget_output_status *widget);
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+
+#include "registry.h"
+
+struct widget_slot_list
+{
+    sys_slist_t instances;
+    bool primed;
+};
+
+static struct widget_slot_list slots[WIDGET_SLOT_COUNT];
+
+bool widget_registry_add(enum widget_slot slot, struct widget_instance *instance, widget_apply_t apply)
+{
+    bool first = !slots[slot].primed;
+
+    instance->apply = apply;
+    sys_slist_append(&slots[slot].instances, &instance->node);
+    slots[slot].primed = true;
+
+    return first;
+}
+
+void widget_registry_remove(enum widget_slot slot, struct widget_instance *instance)
+{
+    sys_slist_find_and_remove(&slots[slot].instances, &instance->node);
+}
+
+void widget_registry_dispatch(enum widget_slot slot, const void *state)
+{
+    struct widget_instance *instance;
+
+    SYS_SLIST_FOR_EACH_CONTAINER(&slots[slot].instances, instance, node)
+    {
+        instance->apply(instance, state);
+    }
+}
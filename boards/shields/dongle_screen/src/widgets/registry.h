@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/slist.h>
+
+/**
+ * @brief State slots, one per kind of widget
+ *
+ * Each slot carries one state type, produced by the ZMK_DISPLAY_WIDGET_LISTENER of the widget
+ * kind. Every instance registered to a slot receives that state.
+ */
+enum widget_slot
+{
+    WIDGET_SLOT_OUTPUT,         // struct output_status_state
+    WIDGET_SLOT_BATTERY,        // struct battery_state
+    WIDGET_SLOT_WPM,            // struct wpm_status_state
+    WIDGET_SLOT_LAYER_ROLLER,   // struct layer_roller_state
+    WIDGET_SLOT_MODIFIERS,      // struct mod_status_state
+    WIDGET_SLOT_HID_INDICATORS, // struct hid_indicators_state
+    WIDGET_SLOT_BRIGHTNESS,     // uint8_t
+    WIDGET_SLOT_COUNT,
+};
+
+struct widget_instance;
+
+typedef void (*widget_apply_t)(struct widget_instance *instance, const void *state);
+
+/**
+ * @brief Registry node, embedded in each widget struct
+ *
+ * The widget struct itself holds all per-instance objects, so any number of instances can
+ * exist. Use CONTAINER_OF in the apply function to get back to it.
+ */
+struct widget_instance
+{
+    sys_snode_t node;
+    widget_apply_t apply;
+};
+
+/**
+ * @brief Register a widget instance to a slot
+ *
+ * @return true if this is the first instance ever registered to the slot
+ */
+bool widget_registry_add(enum widget_slot slot, struct widget_instance *instance, widget_apply_t apply);
+
+void widget_registry_remove(enum widget_slot slot, struct widget_instance *instance);
+
+/**
+ * @brief Apply a state to every instance of a slot, called from the display work queue
+ */
+void widget_registry_dispatch(enum widget_slot slot, const void *state);
+
+/**
+ * @brief Register a widget and bring it up to date
+ *
+ * The first instance of a slot primes the widget listener with a fresh state query. Later
+ * instances, e.g. when a page is shown again, get the listener's cached state applied to
+ * themselves only, instead of another dispatch pass over all instances.
+ */
+#define WIDGET_REGISTRY_ADD(slot, instance, apply_fn, listener)                                    \
+    do                                                                                             \
+    {                                                                                              \
+        if (widget_registry_add(slot, instance, apply_fn))                                         \
+        {                                                                                          \
+            listener##_init();                                                                     \
+        }                                                                                          \
+        else                                                                                       \
+        {                                                                                          \
+            __typeof__(listener##_get_local_state()) __state = listener##_get_local_state();       \
+            apply_fn(instance, &__state);                                                          \
+        }                                                                                          \
+    } while (0)
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <string.h>
+#include <lvgl.h>
+
+/*
+ * Retained-state setters for widgets.
+ *
+ * LVGL invalidates an object on every property set, even if the value did not change. These
+ * helpers compare against the value the object currently has and only touch LVGL on a change,
+ * so widgets can apply their whole state on every event. No shadow copy is kept, the object
+ * itself is the retained state. Each helper returns true if the property was changed.
+ */
+
+static inline bool retained_label_set_text(lv_obj_t *label, const char *text)
+{
+    const char *current = lv_label_get_text(label);
+
+    if (current && strcmp(current, text) == 0)
+    {
+        return false;
+    }
+    lv_label_set_text(label, text);
+    return true;
+}
+
+static inline bool retained_set_text_color(lv_obj_t *obj, lv_color_t color, lv_part_t part)
+{
+    if (lv_color_eq(lv_obj_get_style_text_color(obj, part), color))
+    {
+        return false;
+    }
+    lv_obj_set_style_text_color(obj, color, part);
+    return true;
+}
+
+static inline bool retained_set_text_font(lv_obj_t *obj, const lv_font_t *font, lv_part_t part)
+{
+    if (lv_obj_get_style_text_font(obj, part) == font)
+    {
+        return false;
+    }
+    lv_obj_set_style_text_font(obj, font, part);
+    return true;
+}
+
+static inline bool retained_set_bg_color(lv_obj_t *obj, lv_color_t color, lv_part_t part)
+{
+    if (lv_color_eq(lv_obj_get_style_bg_color(obj, part), color))
+    {
+        return false;
+    }
+    lv_obj_set_style_bg_color(obj, color, part);
+    return true;
+}
+
+static inline bool retained_set_border_color(lv_obj_t *obj, lv_color_t color, lv_part_t part)
+{
+    if (lv_color_eq(lv_obj_get_style_border_color(obj, part), color))
+    {
+        return false;
+    }
+    lv_obj_set_style_border_color(obj, color, part);
+    return true;
+}
+
+static inline bool retained_set_hidden(lv_obj_t *obj, bool hidden)
+{
+    if (lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN) == hidden)
+    {
+        return false;
+    }
+    if (hidden)
+    {
+        lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    }
+    else
+    {
+        lv_obj_remove_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    }
+    return true;
+}
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: MIT
  */
 
+#include <string.h>
 #include <zephyr/kernel.h>
 
 #include <zephyr/logging/log.h>
@@ -22,18 +23,146 @@ LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 #define WPM_BAR_MIN 0
 #define WPM_BAR_MAX 160
 
-static sys_slist_t widgets = SYS_SLIST_STATIC_INIT(&widgets);
 struct wpm_status_state
 {
     int wpm;
 };
 
-struct wpm_object {
-    lv_obj_t *bar;
-} wpm_object;
-
 static lv_style_t style_bg;
 static lv_style_t style_indic;
+static bool styles_initialized = false;
+
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_WPM_SPARKLINE)
+
+// Opacity of the area below the line, the line itself is opaque
+#define WPM_CHART_FILL_OPA LV_OPA_40
+
+static lv_style_t style_chart;
+
+// The last WPM_CHART_WIDTH samples, sample n is stored at n % WPM_CHART_WIDTH
+static uint8_t wpm_history[WPM_CHART_WIDTH];
+static uint32_t wpm_samples;
+
+// Latest WPM reported, sampled into the history by wpm_sample_work
+static int wpm_latest;
+
+static void wpm_history_add(int wpm)
+{
+    wpm_history[wpm_samples % WPM_CHART_WIDTH] = CLAMP(wpm, WPM_BAR_MIN, WPM_BAR_MAX);
+    wpm_samples++;
+}
+
+static int wpm_chart_column_top(uint8_t wpm)
+{
+    return WPM_CHART_HEIGHT - DIV_ROUND_UP(wpm * WPM_CHART_HEIGHT, WPM_BAR_MAX);
+}
+
+// Highest row reached by the samples the chart shows
+static int wpm_chart_top(void)
+{
+    int top = WPM_CHART_HEIGHT;
+
+    for (uint32_t i = 0; i < MIN(wpm_samples, WPM_CHART_WIDTH); i++)
+    {
+        top = MIN(top, wpm_chart_column_top(wpm_history[i]));
+    }
+    return top;
+}
+
+static void wpm_chart_draw_column(uint8_t *buf, uint32_t stride, int x, uint8_t wpm)
+{
+    int top = wpm_chart_column_top(wpm);
+
+    for (int y = 0; y < WPM_CHART_HEIGHT; y++)
+    {
+        buf[y * stride + x] = y < top ? LV_OPA_TRANSP : (y == top ? LV_OPA_COVER : WPM_CHART_FILL_OPA);
+    }
+}
+
+/*
+ * The chart is an A8 canvas tinted by the image recolor. For every new sample the canvas
+ * scrolls left by one column and only the new column on the right is drawn. A full redraw
+ * only happens when the widget is created or fell behind by a whole chart width.
+ *
+ * The scroll moves every column, so on screen every row a column reaches changes and has to
+ * be flushed. Only the rows above the highest column, before and after the scroll, stay
+ * transparent and are left out of the invalidated area.
+ */
+static void wpm_chart_update(struct zmk_widget_wpm_status *widget)
+{
+    uint32_t pending = wpm_samples - widget->chart_samples;
+    uint32_t stride = lv_draw_buf_width_to_stride(WPM_CHART_WIDTH, LV_COLOR_FORMAT_A8);
+    uint8_t *buf = widget->chart_buf;
+
+    if (pending == 0)
+    {
+        return;
+    }
+
+    if (widget->chart_samples == 0 || pending >= WPM_CHART_WIDTH)
+    {
+        memset(buf, 0, sizeof(widget->chart_buf));
+
+        uint32_t count = MIN(wpm_samples, WPM_CHART_WIDTH);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            uint32_t sample = wpm_samples - count + i;
+            wpm_chart_draw_column(buf, stride, WPM_CHART_WIDTH - count + i,
+                                  wpm_history[sample % WPM_CHART_WIDTH]);
+        }
+    }
+    else
+    {
+        for (uint32_t sample = widget->chart_samples; sample < wpm_samples; sample++)
+        {
+            for (int y = 0; y < WPM_CHART_HEIGHT; y++)
+            {
+                memmove(&buf[y * stride], &buf[y * stride + 1], WPM_CHART_WIDTH - 1);
+            }
+            wpm_chart_draw_column(buf, stride, WPM_CHART_WIDTH - 1, wpm_history[sample % WPM_CHART_WIDTH]);
+        }
+    }
+
+    int top = wpm_chart_top();
+    lv_area_t area;
+
+    lv_obj_get_coords(widget->chart, &area);
+    area.y1 += MIN(top, widget->chart_top);
+    widget->chart_samples = wpm_samples;
+    widget->chart_top = top;
+
+    if (area.y1 <= area.y2)
+    {
+        lv_obj_invalidate_area(widget->chart, &area);
+    }
+}
+
+/*
+ * ZMK only reports the WPM when it changes, so the chart takes a sample on a fixed interval
+ * instead of one per event. Each column is the same stretch of time, and a steady speed or a
+ * pause keeps scrolling. Once every column shown is zero the chart can't change anymore, the
+ * sampling stops until the next event.
+ */
+static void wpm_sample_work_cb(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(wpm_sample_work, wpm_sample_work_cb);
+
+static void wpm_sample_work_cb(struct k_work *work)
+{
+    if (wpm_latest == 0 && wpm_chart_top() == WPM_CHART_HEIGHT)
+    {
+        return;
+    }
+
+    struct wpm_status_state state = {.wpm = wpm_latest};
+
+    wpm_history_add(state.wpm);
+    widget_registry_dispatch(WIDGET_SLOT_WPM, &state);
+
+    k_work_schedule_for_queue(zmk_display_work_q(), &wpm_sample_work,
+                              K_MSEC(CONFIG_DONGLE_SCREEN_WPM_SPARKLINE_INTERVAL_MS));
+}
+
+#endif
 
 static struct wpm_status_state get_state(const zmk_event_t *_eh)
 {
@@ -44,21 +173,41 @@ static struct wpm_status_state get_state(const zmk_event_t *_eh)
 
 static void set_wpm(struct zmk_widget_wpm_status *widget, struct wpm_status_state state)
 {
-    // Create the three objects associated with the wpm_object so we can manipulate them
-    lv_obj_t *bar = wpm_object.bar;
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_WPM_SPARKLINE)
+    // The chart is drawn from the history, which already holds this state
+    ARG_UNUSED(state);
+
+    if (widget->chart)
+    {
+        wpm_chart_update(widget);
+    }
+#else
+    lv_obj_t *bar = widget->bar;
+    if (!bar) return;
 
     if (state.wpm > WPM_BAR_MAX) { state.wpm = WPM_BAR_MAX; }
 
     lv_bar_set_value(bar, state.wpm, LV_ANIM_ON);
+#endif
+}
+
+static void wpm_status_apply(struct widget_instance *instance, const void *state)
+{
+    set_wpm(CONTAINER_OF(instance, struct zmk_widget_wpm_status, instance),
+            *(const struct wpm_status_state *)state);
 }
 
 static void wpm_status_update_cb(struct wpm_status_state state)
 {
-    struct zmk_widget_wpm_status *widget;
-    SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node)
-    {
-        set_wpm(widget, state);
-    }
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_WPM_SPARKLINE)
+    // Only the next sample picks it up. Doesn't move a sample already scheduled, events come
+    // faster than the interval while typing.
+    wpm_latest = state.wpm;
+    k_work_schedule_for_queue(zmk_display_work_q(), &wpm_sample_work,
+                              K_MSEC(CONFIG_DONGLE_SCREEN_WPM_SPARKLINE_INTERVAL_MS));
+#else
+    widget_registry_dispatch(WIDGET_SLOT_WPM, &state);
+#endif
 }
 
 ZMK_DISPLAY_WIDGET_LISTENER(widget_wpm_status, struct wpm_status_state,
@@ -70,31 +219,54 @@ int zmk_widget_wpm_status_init(struct zmk_widget_wpm_status *widget, lv_obj_t *p
 {
     // Create the widget and set to parent.
     widget->obj = lv_obj_create(parent);
-    lv_obj_set_size(widget->obj, 240, 40);
 
     // Create theobjects and assign each to the widget.
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_WPM_SPARKLINE)
+    lv_obj_t * chart = lv_canvas_create(widget->obj);
+#else
     lv_obj_t * bar = lv_bar_create(widget->obj);
+#endif
     lv_obj_t * wpm_label = lv_label_create(widget->obj);
 
-    // Set the bar style.
-    lv_style_init(&style_bg);
-    lv_style_set_border_color(&style_bg, lv_palette_darken(LV_PALETTE_GREY,3));
-    lv_style_set_border_width(&style_bg, 1);
-    lv_style_set_radius(&style_bg, 10);
+    // Set the bar style once, the widget may be created again when its page is shown.
+    if (!styles_initialized) {
+        styles_initialized = true;
+
+        lv_style_init(&style_bg);
+        lv_style_set_border_color(&style_bg, lv_palette_darken(LV_PALETTE_GREY,3));
+        lv_style_set_border_width(&style_bg, 1);
+        lv_style_set_radius(&style_bg, 10);
+
+        lv_style_init(&style_indic);
+        lv_style_set_bg_opa(&style_indic, LV_OPA_COVER);
+        lv_style_set_bg_color(&style_indic, lv_palette_main(LV_PALETTE_YELLOW));
+        lv_style_set_bg_grad_color(&style_indic, lv_palette_main(LV_PALETTE_BLUE));
+        lv_style_set_bg_grad_dir(&style_indic, LV_GRAD_DIR_HOR);
+        lv_style_set_radius(&style_indic, 8);
+
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_WPM_SPARKLINE)
+        lv_style_init(&style_chart);
+        lv_style_set_image_recolor(&style_chart, lv_palette_main(LV_PALETTE_YELLOW));
+        lv_style_set_image_recolor_opa(&style_chart, LV_OPA_COVER);
+#endif
+    }
 
-    lv_style_init(&style_indic);
-    lv_style_set_bg_opa(&style_indic, LV_OPA_COVER);
-    lv_style_set_bg_color(&style_indic, lv_palette_main(LV_PALETTE_YELLOW));
-    lv_style_set_bg_grad_color(&style_indic, lv_palette_main(LV_PALETTE_BLUE));
-    lv_style_set_bg_grad_dir(&style_indic, LV_GRAD_DIR_HOR);
-    lv_style_set_radius(&style_indic, 8);
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_WPM_SPARKLINE)
+    lv_obj_add_style(chart, &style_chart, 0);
 
+    // Drawn from the whole history by the first update
+    widget->chart_samples = 0;
+    widget->chart_top = WPM_CHART_HEIGHT;
+    memset(widget->chart_buf, 0, sizeof(widget->chart_buf));
+    lv_canvas_set_buffer(chart, widget->chart_buf, WPM_CHART_WIDTH, WPM_CHART_HEIGHT, LV_COLOR_FORMAT_A8);
+#else
     lv_obj_remove_style_all(bar);  /*To have a clean start*/
     lv_obj_add_style(bar, &style_bg, 0);
     lv_obj_add_style(bar, &style_indic, LV_PART_INDICATOR);
 
     lv_obj_set_size(bar, WPM_BAR_LENGTH, WPM_BAR_HEIGHT);
     lv_bar_set_range(bar, WPM_BAR_MIN, WPM_BAR_MAX);
+#endif
 
     // Set the label.
     lv_label_set_text(wpm_label, "Words per Minute");
@@ -102,21 +274,31 @@ int zmk_widget_wpm_status_init(struct zmk_widget_wpm_status *widget, lv_obj_t *p
     lv_obj_set_style_text_color(wpm_label, lv_palette_darken(LV_PALETTE_GREY,3), 0);
     
     // Align all the objects within the newly created widget.
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_WPM_SPARKLINE)
+    lv_obj_align(chart, LV_ALIGN_TOP_LEFT, 0, 0);
+    widget->chart = chart;
+#else
     lv_obj_align(bar, LV_ALIGN_TOP_LEFT, 0, 0);
+    widget->bar = bar;
+#endif
     lv_obj_align(wpm_label, LV_ALIGN_BOTTOM_LEFT, 0, 0); 
 
-    // Create the wmp_object assigning the objects created in this function to the wpm_object.
-    wpm_object = (struct wpm_object){
-            .bar = bar,
-    };
+    widget->wpm_label = wpm_label;
 
-    sys_slist_append(&widgets, &widget->node);
-
-    widget_wpm_status_init();
+    WIDGET_REGISTRY_ADD(WIDGET_SLOT_WPM, &widget->instance, wpm_status_apply, widget_wpm_status);
     
     return 0;
 }
 
+void zmk_widget_wpm_status_deinit(struct zmk_widget_wpm_status *widget)
+{
+    widget_registry_remove(WIDGET_SLOT_WPM, &widget->instance);
+    widget->bar = NULL;
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_WPM_SPARKLINE)
+    widget->chart = NULL;
+#endif
+}
+
 lv_obj_t *zmk_widget_wpm_status_obj(struct zmk_widget_wpm_status *widget)
 {
     return widget->obj;
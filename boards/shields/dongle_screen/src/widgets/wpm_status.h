@@ -9,13 +9,26 @@
 #include <lvgl.h>
 #include <zephyr/kernel.h>
 
+#include "registry.h"
+
+#define WPM_CHART_WIDTH 130
+#define WPM_CHART_HEIGHT 20
+
 struct zmk_widget_wpm_status
 {
     lv_obj_t *obj;
+    lv_obj_t *bar;
     lv_obj_t *wpm_label;
-    lv_obj_t *font_test;
-    sys_snode_t node;
+    struct widget_instance instance;
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_WPM_SPARKLINE)
+    lv_obj_t *chart;
+    uint32_t chart_samples; // Samples drawn into chart_buf so far
+    int32_t chart_top;      // Highest row any column in chart_buf reaches
+    uint8_t chart_buf[LV_CANVAS_BUF_SIZE(WPM_CHART_WIDTH, WPM_CHART_HEIGHT, 8,
+                                         LV_DRAW_BUF_STRIDE_ALIGN)] __aligned(LV_DRAW_BUF_ALIGN);
+#endif
 };
 
 int zmk_widget_wpm_status_init(struct zmk_widget_wpm_status *widget, lv_obj_t *parent);
+void zmk_widget_wpm_status_deinit(struct zmk_widget_wpm_status *widget);
 lv_obj_t *zmk_widget_wpm_status_obj(struct zmk_widget_wpm_status *widget);
\ No newline at end of file
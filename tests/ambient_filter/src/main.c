@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/ztest.h>
+
+#include "ambient_filter.h"
+
+// Enough readings for every filter to reach a constant input, the EMA included
+#define SETTLE_READINGS 40
+
+#define HYSTERESIS_MS CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_HYSTERESIS_MS
+
+static void settle(int32_t value)
+{
+    int32_t out = 0;
+
+    for (int i = 0; i < SETTLE_READINGS; i++)
+    {
+        out = ambient_filter_sample(value);
+    }
+    zassert_equal(out, value, "filter settled at %d instead of %d", out, value);
+}
+
+ZTEST(ambient_filter, test_constant_reading_passes_through)
+{
+    settle(50);
+    settle(80);
+    settle(0);
+}
+
+ZTEST(ambient_filter, test_short_shadow)
+{
+    settle(80);
+
+    // A hand passing over the sensor for two readings
+    int32_t first = ambient_filter_sample(10);
+    int32_t second = ambient_filter_sample(10);
+
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_FILTER_MEDIAN)
+    // Fewer than half of the window, ignored completely
+    zassert_equal(first, 80);
+    zassert_equal(second, 80);
+#elif IS_ENABLED(CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_FILTER_EMA)
+    // Damped, every reading only moves part of the way
+    zassert_true(first < 80 && first > 10, "first shadow reading gave %d", first);
+    zassert_true(second < first && second > 10, "second shadow reading gave %d", second);
+#else
+    zassert_equal(first, 10);
+    zassert_equal(second, 10);
+#endif
+
+    settle(80);
+}
+
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_FILTER_MEDIAN)
+
+ZTEST(ambient_filter, test_median_follows_lasting_change)
+{
+    settle(80);
+
+    for (int i = 0; i < CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_MEDIAN_SIZE / 2; i++)
+    {
+        zassert_equal(ambient_filter_sample(10), 80);
+    }
+    // Once more than half of the window is dark the median follows
+    zassert_equal(ambient_filter_sample(10), 10);
+}
+
+#endif
+
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_FILTER_EMA)
+
+ZTEST(ambient_filter, test_ema_step_response_is_monotonic)
+{
+    int32_t prev = 20;
+
+    settle(20);
+    for (int i = 0; i < SETTLE_READINGS; i++)
+    {
+        int32_t out = ambient_filter_sample(100);
+
+        zassert_true(out >= prev && out <= 100, "step response went from %d to %d", prev, out);
+        prev = out;
+    }
+    zassert_equal(prev, 100);
+}
+
+#endif
+
+ZTEST(ambient_filter, test_hysteresis_holds_changes)
+{
+    // Forget a change held back by an earlier test
+    ambient_filter_hold(false, 0);
+    zassert_false(ambient_filter_pending());
+
+    zassert_equal(ambient_filter_hold(true, 1000), HYSTERESIS_MS == 0);
+    if (HYSTERESIS_MS == 0)
+    {
+        return;
+    }
+
+    zassert_true(ambient_filter_pending());
+    zassert_false(ambient_filter_hold(true, 1000 + HYSTERESIS_MS - 1));
+    zassert_true(ambient_filter_hold(true, 1000 + HYSTERESIS_MS));
+    zassert_false(ambient_filter_pending());
+
+    // A change that falls back in between starts over
+    zassert_false(ambient_filter_hold(true, 10000));
+    zassert_false(ambient_filter_hold(false, 10000 + HYSTERESIS_MS / 2));
+    zassert_false(ambient_filter_hold(true, 10000 + HYSTERESIS_MS));
+    zassert_true(ambient_filter_pending());
+}
+
+ZTEST_SUITE(ambient_filter, NULL, NULL, NULL, NULL, NULL);
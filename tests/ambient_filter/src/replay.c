@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdlib.h>
+#include <zephyr/ztest.h>
+
+#include "ambient_filter.h"
+#include "ambient_trace.h"
+
+#define SAMPLE_INTERVAL_MS 1000
+#define TRACE_DAY_MS (24 * 60 * 60 * 1000)
+#define SETTLE_READINGS 40
+
+// Same as brightness.c with the default raw range of 0-100 and brightness range of 1-100
+#define BRIGHTNESS_CHANGE_THRESHOLD 5
+
+static uint8_t to_brightness(int32_t raw)
+{
+    return 1 + (CLAMP(raw, 0, 100) * 99) / 100;
+}
+
+struct fade_count
+{
+    uint8_t last;
+    uint32_t fades;
+};
+
+static bool exceeds(const struct fade_count *count, uint8_t brightness)
+{
+    return count->last == 0xFF || abs(brightness - count->last) > BRIGHTNESS_CHANGE_THRESHOLD;
+}
+
+static void fade(struct fade_count *count, uint8_t brightness)
+{
+    count->last = brightness;
+    count->fades++;
+}
+
+// Uptime counts are logged by the trace replay every simulated hour
+uint32_t backlight_update_count(void)
+{
+    return 0;
+}
+
+uint32_t zmk_widget_brightness_status_update_count(void)
+{
+    return 0;
+}
+
+/*
+ * One day of the trace sampled at a fixed interval: the fades every raw reading would start,
+ * against the fades after the configured filter and hysteresis, like ambient_light_evaluate().
+ * 40 fades unfiltered. The median alone keeps 40, a hysteresis of 5 s brings it down to 30.
+ * The EMA alone raises it to 55, because it spreads every sudden change over several
+ * threshold crossings, so it is only tested together with a hysteresis (34 fades).
+ */
+ZTEST(ambient_filter_replay, test_filter_does_not_add_fades)
+{
+    struct fade_count unfiltered = {.last = 0xFF};
+    struct fade_count filtered = {.last = 0xFF};
+
+    // Start from the first reading of the trace, not from what earlier tests left behind
+    for (int i = 0; i < SETTLE_READINGS; i++)
+    {
+        ambient_filter_sample(ambient_trace_read());
+    }
+    ambient_filter_hold(false, ambient_trace_now_ms());
+
+    for (int64_t t = 0; t < TRACE_DAY_MS; t += SAMPLE_INTERVAL_MS)
+    {
+        int32_t raw = ambient_trace_read();
+        uint8_t brightness = to_brightness(raw);
+
+        if (exceeds(&unfiltered, brightness))
+        {
+            fade(&unfiltered, brightness);
+        }
+
+        brightness = to_brightness(ambient_filter_sample(raw));
+        bool change = exceeds(&filtered, brightness);
+
+        if (filtered.last == 0xFF ? change : ambient_filter_hold(change, ambient_trace_now_ms()))
+        {
+            fade(&filtered, brightness);
+        }
+
+        ambient_trace_advance(SAMPLE_INTERVAL_MS);
+    }
+
+    TC_PRINT("Trace day: %u fades unfiltered, %u filtered with %d ms hysteresis\n", unfiltered.fades,
+             filtered.fades, CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_HYSTERESIS_MS);
+
+    zassert_true(filtered.fades <= unfiltered.fades);
+#if CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_HYSTERESIS_MS > 0
+    zassert_true(filtered.fades < unfiltered.fades, "hysteresis saved no fades");
+#endif
+}
+
+ZTEST_SUITE(ambient_filter_replay, NULL, NULL, NULL, NULL, NULL);
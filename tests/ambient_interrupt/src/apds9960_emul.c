@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#define DT_DRV_COMPAT avago_apds9960
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/drivers/i2c_emul.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/gpio/gpio_emul.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "apds9960_emul.h"
+
+#define APDS9960_EMUL_ID_VALUE 0xAB
+#define STATUS_AVALID BIT(0)
+#define STATUS_AINT BIT(4)
+#define ENABLE_AIEN BIT(4)
+
+struct apds9960_emul apds9960_emul;
+
+static const struct gpio_dt_spec als_int = GPIO_DT_SPEC_INST_GET(0, int_gpios);
+
+uint16_t apds9960_emul_window_low(void)
+{
+    return sys_get_le16(&apds9960_emul.regs[APDS9960_EMUL_AILTL]);
+}
+
+uint16_t apds9960_emul_window_high(void)
+{
+    return sys_get_le16(&apds9960_emul.regs[APDS9960_EMUL_AILTL + 2]);
+}
+
+void apds9960_emul_set_light(uint16_t clear)
+{
+    sys_put_le16(clear, &apds9960_emul.regs[APDS9960_EMUL_CDATAL]);
+    apds9960_emul.regs[APDS9960_EMUL_STATUS] |= STATUS_AVALID;
+
+    bool outside = clear < apds9960_emul_window_low() || clear > apds9960_emul_window_high();
+
+    if (!(apds9960_emul.regs[APDS9960_EMUL_ENABLE] & ENABLE_AIEN) || !outside ||
+        apds9960_emul.int_asserted)
+    {
+        return;
+    }
+
+    apds9960_emul.regs[APDS9960_EMUL_STATUS] |= STATUS_AINT;
+    apds9960_emul.int_asserted = true;
+    apds9960_emul.interrupts++;
+
+    // Active low: a falling edge, the callback runs right away in this context
+    gpio_emul_input_set(als_int.port, als_int.pin, 1);
+    gpio_emul_input_set(als_int.port, als_int.pin, 0);
+}
+
+static void write_reg(uint8_t reg, uint8_t value)
+{
+    apds9960_emul.regs[reg] = value;
+}
+
+static uint8_t read_reg(uint8_t reg)
+{
+    if (reg == APDS9960_EMUL_STATUS)
+    {
+        apds9960_emul.status_reads++;
+    }
+    else if (reg == APDS9960_EMUL_CDATAL)
+    {
+        apds9960_emul.clear_reads++;
+    }
+    return apds9960_emul.regs[reg];
+}
+
+// The first written byte of a transfer selects the register, which then auto-increments for
+// the following bytes, written or read
+static int apds9960_emul_transfer(const struct emul *target, struct i2c_msg *msgs, int num_msgs,
+                                  int addr)
+{
+    bool addressed = false;
+    uint8_t reg = 0;
+
+    for (int i = 0; i < num_msgs; i++)
+    {
+        struct i2c_msg *msg = &msgs[i];
+
+        for (uint32_t j = 0; j < msg->len; j++)
+        {
+            if (msg->flags & I2C_MSG_READ)
+            {
+                msg->buf[j] = read_reg(reg++);
+            }
+            else if (!addressed)
+            {
+                reg = msg->buf[j];
+                addressed = true;
+
+                // Addressing AICLEAR is the whole command, it takes no data
+                if (reg == APDS9960_EMUL_AICLEAR)
+                {
+                    apds9960_emul.aiclears++;
+                    apds9960_emul.regs[APDS9960_EMUL_STATUS] &= ~STATUS_AINT;
+                    apds9960_emul.int_asserted = false;
+                }
+            }
+            else
+            {
+                write_reg(reg++, msg->buf[j]);
+            }
+        }
+    }
+    return 0;
+}
+
+static const struct i2c_emul_api apds9960_emul_api = {
+    .transfer = apds9960_emul_transfer,
+};
+
+static int apds9960_emul_init(const struct emul *target, const struct device *parent)
+{
+    apds9960_emul.regs[APDS9960_EMUL_ID] = APDS9960_EMUL_ID_VALUE;
+    return 0;
+}
+
+EMUL_DT_INST_DEFINE(0, apds9960_emul_init, NULL, NULL, &apds9960_emul_api, NULL);
+
+// An emulator needs a device on its node, the Zephyr APDS9960 driver isn't built in this test
+DEVICE_DT_INST_DEFINE(0, NULL, NULL, NULL, NULL, POST_KERNEL, CONFIG_I2C_INIT_PRIORITY, NULL);
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// I2C target for the ALS registers apds9960_als.c uses, on the emulated i2c0 of native_sim
+
+#define APDS9960_EMUL_ENABLE 0x80
+#define APDS9960_EMUL_ATIME 0x81
+#define APDS9960_EMUL_AILTL 0x84
+#define APDS9960_EMUL_PERS 0x8C
+#define APDS9960_EMUL_CONTROL 0x8F
+#define APDS9960_EMUL_ID 0x92
+#define APDS9960_EMUL_STATUS 0x93
+#define APDS9960_EMUL_CDATAL 0x94
+#define APDS9960_EMUL_AICLEAR 0xE7
+
+struct apds9960_emul
+{
+    uint8_t regs[256];
+    uint32_t status_reads;  // Reads of STATUS, one per apds9960_als_read()
+    uint32_t clear_reads;   // Reads of CDATAL, the ones that returned a value
+    uint32_t aiclears;      // Writes to AICLEAR, one per apds9960_als_set_window()
+    uint32_t interrupts;    // Edges raised on the interrupt line
+    bool int_asserted;      // Line held low until the next AICLEAR
+};
+
+extern struct apds9960_emul apds9960_emul;
+
+// Low and high threshold as last written with apds9960_als_set_window()
+uint16_t apds9960_emul_window_low(void);
+uint16_t apds9960_emul_window_high(void);
+
+/**
+ * @brief Complete a conversion of @p clear
+ *
+ * Sets AVALID and, like the sensor with the interrupt enabled, pulls the interrupt line when the
+ * value is outside of the window. The persistence filter isn't modelled, the interrupt comes
+ * with the first conversion.
+ */
+void apds9960_emul_set_light(uint16_t clear);
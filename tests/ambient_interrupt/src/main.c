@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "apds9960_als.h"
+#include "apds9960_emul.h"
+#include "fake_backlight.h"
+
+#define EVALUATION_INTERVAL_MS CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_EVALUATION_INTERVAL_MS
+// A step of the light moves the median of 5 after 3 readings, in any case done after this
+#define SETTLE_MS (CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_MEDIAN_SIZE * EVALUATION_INTERVAL_MS)
+
+// 10*x maps to brightness 1 + 99*x/100, window half width 60
+#define ROOM 300
+#define ROOM_LEVEL 30
+#define DARK 100
+#define DARK_LEVEL 10
+
+static uint8_t init_regs[256];
+static uint32_t eagain_reads;
+static uint32_t eagain_clear_reads;
+static uint32_t reads_until_value;
+
+// Let the brightness work queue handle what is due and play the fades to the end
+static void run(uint32_t ms)
+{
+    k_msleep(ms);
+    fake_backlight_advance(BACKLIGHT_SEQUENCE_MAX_LEN);
+}
+
+static void *setup(void)
+{
+    // init_fixed_brightness() queued the sensor work at boot: apds9960_als_init() and a first
+    // read that finds no conversion yet
+    run(1);
+    memcpy(init_regs, apds9960_emul.regs, sizeof(init_regs));
+
+    // And again, as long as AVALID stays clear
+    run(APDS9960_ALS_CONVERSION_MS + 10);
+    eagain_reads = apds9960_emul.status_reads;
+    eagain_clear_reads = apds9960_emul.clear_reads;
+
+    apds9960_emul_set_light(ROOM);
+    run(APDS9960_ALS_CONVERSION_MS + 10);
+    reads_until_value = apds9960_emul.status_reads;
+    return NULL;
+}
+
+static void before(void *fixture)
+{
+    // Every test starts armed around ROOM, whatever light a previous test left
+    apds9960_emul_set_light(ROOM);
+    run(SETTLE_MS);
+    zassert_equal(fake_backlight.level, ROOM_LEVEL, "a previous test left the screen at %d",
+                  fake_backlight.level);
+    zassert_false(apds9960_emul.int_asserted);
+}
+
+ZTEST(ambient_interrupt, test_init_registers)
+{
+    zassert_equal(init_regs[APDS9960_EMUL_ATIME], 219);
+    zassert_equal(init_regs[APDS9960_EMUL_CONTROL] & 0x03, 0x01, "gain isn't 4x");
+    zassert_equal(init_regs[APDS9960_EMUL_PERS] & 0x0F, 4, "APERS isn't 5 readings");
+    zassert_equal(init_regs[APDS9960_EMUL_ENABLE], 0x13, "PON, AEN and AIEN");
+
+    // No interrupt before the first reading is known
+    zassert_equal(sys_get_le16(&init_regs[APDS9960_EMUL_AILTL]), 0);
+    zassert_equal(sys_get_le16(&init_regs[APDS9960_EMUL_AILTL + 2]), UINT16_MAX);
+}
+
+ZTEST(ambient_interrupt, test_first_read_waits_for_avalid)
+{
+    zassert_true(eagain_reads >= 2, "no retry after -EAGAIN");
+
+    zassert_equal(eagain_clear_reads, 0, "read the data without AVALID");
+
+    // The retry right after the conversion got the value
+    zassert_equal(reads_until_value, eagain_reads + 1);
+}
+
+ZTEST(ambient_interrupt, test_window_around_reading)
+{
+    zassert_equal(apds9960_emul_window_low(), ROOM - 60);
+    zassert_equal(apds9960_emul_window_high(), ROOM + 60);
+}
+
+ZTEST(ambient_interrupt, test_sleeps_inside_window)
+{
+    uint32_t reads = apds9960_emul.status_reads;
+    uint32_t interrupts = apds9960_emul.interrupts;
+
+    apds9960_emul_set_light(ROOM + 50);
+    run(SETTLE_MS);
+    apds9960_emul_set_light(ROOM - 50);
+    run(SETTLE_MS);
+
+    zassert_equal(apds9960_emul.interrupts, interrupts);
+    zassert_equal(apds9960_emul.status_reads, reads, "the sensor was polled while armed");
+    zassert_equal(fake_backlight.level, ROOM_LEVEL);
+}
+
+ZTEST(ambient_interrupt, test_polls_until_filter_settles)
+{
+    uint32_t reads = apds9960_emul.clear_reads;
+    uint32_t aiclears = apds9960_emul.aiclears;
+
+    // Darker than anything the other tests read, so at least 3 readings of ROOM or brighter
+    // stay in the median window and it takes 3 readings of DARK to move it
+    apds9960_emul_set_light(DARK);
+    zassert_true(apds9960_emul.int_asserted);
+
+    // The interrupt reading alone doesn't move the median, so no new window yet
+    run(1);
+    zassert_equal(apds9960_emul.clear_reads, reads + 1);
+    zassert_equal(apds9960_emul.aiclears, aiclears, "armed before the filter settled");
+    zassert_equal(fake_backlight.level, ROOM_LEVEL);
+
+    // Polled at the evaluation interval instead
+    run(EVALUATION_INTERVAL_MS);
+    zassert_equal(apds9960_emul.clear_reads, reads + 2);
+    zassert_equal(fake_backlight.level, ROOM_LEVEL);
+
+    run(EVALUATION_INTERVAL_MS);
+    zassert_equal(apds9960_emul.clear_reads, reads + 3);
+    zassert_equal(fake_backlight.level, DARK_LEVEL);
+    zassert_equal(apds9960_emul.aiclears, aiclears + 1);
+    zassert_equal(apds9960_emul_window_low(), DARK - 60);
+    zassert_false(apds9960_emul.int_asserted);
+
+    // Settled and armed, no more polling
+    run(SETTLE_MS);
+    zassert_equal(apds9960_emul.clear_reads, reads + 3);
+}
+
+ZTEST(ambient_interrupt, test_rearms_after_interrupt)
+{
+    uint32_t interrupts = apds9960_emul.interrupts;
+
+    apds9960_emul_set_light(700);
+    run(SETTLE_MS);
+    zassert_equal(fake_backlight.level, 70);
+    zassert_equal(apds9960_emul_window_low(), 640);
+    zassert_equal(apds9960_emul_window_high(), 760);
+
+    // The new window fires again, in both directions
+    apds9960_emul_set_light(800);
+    run(SETTLE_MS);
+    zassert_equal(fake_backlight.level, 80);
+    zassert_equal(apds9960_emul_window_low(), 740);
+    zassert_equal(apds9960_emul_window_high(), 860);
+
+    apds9960_emul_set_light(600);
+    run(SETTLE_MS);
+    zassert_equal(fake_backlight.level, 60);
+    zassert_equal(apds9960_emul.interrupts, interrupts + 3);
+}
+
+ZTEST(ambient_interrupt, test_window_open_beyond_range)
+{
+    apds9960_emul_set_light(2000);
+    run(SETTLE_MS);
+    zassert_equal(fake_backlight.level, CONFIG_DONGLE_SCREEN_MAX_BRIGHTNESS);
+
+    // Brighter still changes nothing, so there's no upper threshold
+    zassert_equal(apds9960_emul_window_low(), 1000 - 60);
+    zassert_equal(apds9960_emul_window_high(), UINT16_MAX);
+}
+
+ZTEST_SUITE(ambient_interrupt, NULL, setup, before, NULL, NULL);
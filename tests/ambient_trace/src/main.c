@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdlib.h>
+#include <zephyr/ztest.h>
+#include <lvgl.h>
+
+#include "ambient_filter.h"
+#include "ambient_trace.h"
+#include "brightness_fade.h"
+#include "fake_backlight.h"
+#include "widgets/brightness_status.h"
+
+#define MS_PER_HOUR (60 * 60 * 1000)
+#define TRACE_DAY_MS (24 * MS_PER_HOUR)
+#define AT(h, m, s) ((((h) * 60 + (m)) * 60 + (s)) * 1000)
+
+#define SAMPLE_INTERVAL_MS 1000
+
+// Same as brightness.c with the default raw range of 0-100 and brightness range of 1-100
+#define BRIGHTNESS_CHANGE_THRESHOLD 5
+
+static struct zmk_widget_brightness_status widget;
+
+// Move the simulated clock forward to @p t_ms into the trace day, the next day if already past
+static void trace_seek(int64_t t_ms)
+{
+    int64_t now = ambient_trace_now_ms();
+    int64_t target = now - (now % TRACE_DAY_MS) + t_ms;
+
+    if (target < now)
+    {
+        target += TRACE_DAY_MS;
+    }
+    if (target > now)
+    {
+        ambient_trace_advance(target - now);
+    }
+}
+
+static uint8_t to_brightness(int32_t raw)
+{
+    return 1 + (CLAMP(raw, 0, 100) * 99) / 100;
+}
+
+ZTEST(ambient_trace, test_trajectory)
+{
+    trace_seek(AT(0, 0, 0));
+    zassert_equal(ambient_trace_read(), 2);
+
+    // Dawn ramps linearly from 2 at 5:30 to 10 at 6:00
+    trace_seek(AT(5, 45, 0));
+    zassert_equal(ambient_trace_read(), 6);
+    trace_seek(AT(6, 0, 0));
+    zassert_equal(ambient_trace_read(), 10);
+
+    // Cloud, hand and the lamp switched off are sudden
+    trace_seek(AT(10, 20, 5));
+    zassert_equal(ambient_trace_read(), 35);
+    trace_seek(AT(13, 5, 2));
+    zassert_equal(ambient_trace_read(), 20);
+    trace_seek(AT(13, 5, 4));
+    zassert_equal(ambient_trace_read(), 110);
+    trace_seek(AT(22, 0, 1));
+    zassert_equal(ambient_trace_read(), 4);
+
+    // The next day replays the same readings
+    trace_seek(AT(6, 0, 0));
+    zassert_equal(ambient_trace_read(), 10);
+}
+
+ZTEST(ambient_trace, test_advance_is_sped_up)
+{
+    k_timeout_t wait = ambient_trace_advance(60 * 1000);
+
+    zassert_true(K_TIMEOUT_EQ(wait, K_MSEC(60 * 1000 / CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT_TEST_SPEEDUP)));
+
+    // Never a busy loop, even for short steps
+    wait = ambient_trace_advance(1);
+    zassert_true(K_TIMEOUT_EQ(wait, K_MSEC(1)));
+}
+
+/*
+ * A day of the trace through the median filter, the fades and the brightness overlay, like
+ * ambient_light_evaluate() with a fixed sampling interval and no hysteresis. The fades per hour
+ * are pinned to the trace, the backlight and LVGL updates have to stay within what those fades
+ * may cost.
+ */
+ZTEST(ambient_trace, test_updates_per_hour)
+{
+    static const uint8_t expected_fades[24] = {
+        1, 0, 0, 0, 0, 1, 5, 5, 3, 1, 10, 0, 0, 2, 0, 2, 2, 4, 3, 0, 0, 0, 1, 0,
+    };
+    uint8_t last = 0xFF;
+
+    zmk_widget_brightness_status_init(&widget, lv_screen_active());
+    fake_backlight_reset(0);
+    trace_seek(AT(0, 0, 0));
+
+    for (int hour = 0; hour < 24; hour++)
+    {
+        uint32_t pwm_start = backlight_update_count();
+        uint32_t lvgl_start = zmk_widget_brightness_status_update_count();
+        uint32_t fades = 0;
+
+        for (int i = 0; i < MS_PER_HOUR / SAMPLE_INTERVAL_MS; i++)
+        {
+            uint8_t brightness = to_brightness(ambient_filter_sample(ambient_trace_read()));
+
+            if (last == 0xFF || abs(brightness - last) > BRIGHTNESS_CHANGE_THRESHOLD)
+            {
+                brightness_fade_to(brightness);
+                zmk_widget_update_brightness_status(&widget, brightness);
+                last = brightness;
+                fades++;
+            }
+
+            // A fade takes at most a second, it is over before the next reading
+            fake_backlight_advance(BACKLIGHT_SEQUENCE_MAX_LEN);
+            k_sleep(ambient_trace_advance(SAMPLE_INTERVAL_MS));
+            lv_timer_handler();
+        }
+
+        uint32_t pwm = backlight_update_count() - pwm_start;
+        uint32_t lvgl = zmk_widget_brightness_status_update_count() - lvgl_start;
+
+        TC_PRINT("Trace hour %2d: %u fades, %u backlight updates, %u LVGL updates\n", hour, fades, pwm, lvgl);
+
+        zassert_equal(fades, expected_fades[hour], "hour %d", hour);
+        // Every fade changes the level at least once and plays at most a full sequence
+        zassert_true(pwm >= fades && pwm <= fades * (BACKLIGHT_SEQUENCE_MAX_LEN - 1), "hour %d", hour);
+        // The new value, and unhiding the overlay unless it is still shown
+        zassert_true(lvgl >= fades && lvgl <= fades * 2, "hour %d", hour);
+    }
+}
+
+ZTEST_SUITE(ambient_trace, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/ztest.h>
+
+#include "battery_history.h"
+
+#define MS_PER_MIN (60 * 1000)
+
+// Minute of the last sample of every history, the tests run on their own clock
+static int64_t last_min;
+
+// One sample per percent from `from` down to `to`, `step_min` minutes apart
+static void drain(uint8_t source, uint8_t from, uint8_t to, int step_min)
+{
+    for (int level = from; level >= to; level--)
+    {
+        last_min += step_min;
+        battery_history_add(source, level, false, last_min * MS_PER_MIN);
+    }
+}
+
+static int32_t remaining(uint8_t source)
+{
+    return battery_history_minutes_remaining(source, last_min * MS_PER_MIN);
+}
+
+static void before(void *fixture)
+{
+    last_min = 0;
+    battery_history_add(0, 100, true, 0);
+    battery_history_add(1, 100, true, 0);
+}
+
+ZTEST(battery_history, test_steady_drain)
+{
+    drain(0, 90, 89, 10);
+    zassert_equal(remaining(0), -1, "estimated from two samples");
+
+    drain(0, 88, 85, 10);
+    // 1% every 10 minutes, exact in the integer fit
+    zassert_equal(remaining(0), 850);
+}
+
+ZTEST(battery_history, test_time_since_last_sample_counts)
+{
+    drain(0, 90, 85, 10);
+
+    int64_t now_ms = (last_min + 30) * MS_PER_MIN;
+
+    zassert_equal(battery_history_minutes_remaining(0, now_ms), 820);
+
+    // Long past the fitted empty time the estimate stops at 0 instead of going negative
+    now_ms = (last_min + 2000) * MS_PER_MIN;
+    zassert_equal(battery_history_minutes_remaining(0, now_ms), 0);
+}
+
+ZTEST(battery_history, test_window_follows_the_recent_rate)
+{
+    drain(0, 100, 90, 5);
+    drain(0, 89, 80, 10);
+
+    // The 8 samples in the ring all drained 1% every 10 minutes
+    zassert_equal(remaining(0), 800);
+}
+
+ZTEST(battery_history, test_jitter_keeps_the_history)
+{
+    drain(0, 90, 85, 10);
+
+    // Reporting jitter of one or two percent is no charge
+    last_min += 10;
+    battery_history_add(0, 87, false, last_min * MS_PER_MIN);
+    zassert_true(remaining(0) > 0, "a 2%% bump dropped the history");
+
+    last_min += 10;
+    battery_history_add(0, 88, false, last_min * MS_PER_MIN);
+    zassert_equal(remaining(0), -1, "a 3%% rise over the lowest level didn't restart");
+}
+
+ZTEST(battery_history, test_usb_power_restarts)
+{
+    drain(0, 90, 85, 10);
+
+    last_min += 10;
+    battery_history_add(0, 85, true, last_min * MS_PER_MIN);
+    zassert_equal(remaining(0), -1);
+
+    drain(0, 84, 83, 10);
+    zassert_equal(remaining(0), -1, "samples from before USB power were kept");
+}
+
+ZTEST(battery_history, test_disconnect_is_not_a_reading)
+{
+    drain(1, 90, 85, 10);
+    int32_t before_disconnect = remaining(1);
+
+    battery_history_add(1, 0, false, last_min * MS_PER_MIN);
+    zassert_equal(remaining(1), before_disconnect, "level 0 was recorded");
+
+    // Reconnecting at the same level continues the history
+    last_min += 10;
+    battery_history_add(1, 84, false, last_min * MS_PER_MIN);
+    zassert_true(remaining(1) > 0);
+}
+
+ZTEST(battery_history, test_sources_are_independent)
+{
+    drain(0, 90, 85, 10);
+    zassert_equal(remaining(1), -1);
+    zassert_equal(battery_history_minutes_remaining(2, 0), -1, "unknown source");
+}
+
+ZTEST_SUITE(battery_history, NULL, NULL, before, NULL, NULL);
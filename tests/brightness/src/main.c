@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/ztest.h>
+#include <zmk/events/keycode_state_changed.h>
+#include <zmk/events/layer_state_changed.h>
+
+#include "brightness.h"
+#include "fake_backlight.h"
+#include "fake_brightness_status.h"
+
+extern const struct zmk_listener zmk_listener_screen_idle;
+
+#define DEFAULT_LEVEL CONFIG_DONGLE_SCREEN_DEFAULT_BRIGHTNESS
+#define STEP CONFIG_DONGLE_SCREEN_BRIGHTNESS_STEP
+#define IDLE_TIMEOUT_MS (CONFIG_DONGLE_SCREEN_IDLE_TIMEOUT_S * 1000)
+
+#define KEY_A 4
+#define KEY_UP CONFIG_DONGLE_SCREEN_BRIGHTNESS_UP_KEYCODE
+#define KEY_DOWN CONFIG_DONGLE_SCREEN_BRIGHTNESS_DOWN_KEYCODE
+#define KEY_TOGGLE CONFIG_DONGLE_SCREEN_TOGGLE_KEYCODE
+
+static uint8_t boot_level;
+static uint8_t boot_posted_level;
+
+// Key down, without letting the work queue run yet
+static void raise_key(uint32_t keycode)
+{
+    struct zmk_keycode_state_changed_event ev = {
+        .header = {.event = &zmk_event_zmk_keycode_state_changed},
+        .data = {.keycode = keycode, .state = true},
+    };
+
+    zmk_listener_screen_idle.callback(&ev.header);
+}
+
+static void raise_layer_change(void)
+{
+    struct zmk_layer_state_changed_event ev = {
+        .header = {.event = &zmk_event_zmk_layer_state_changed},
+        .data = {.layer = 1, .state = true},
+    };
+
+    zmk_listener_screen_idle.callback(&ev.header);
+}
+
+// Let the brightness work queue handle what was posted and play the fades to the end
+static void run(void)
+{
+    k_msleep(1);
+    fake_backlight_advance(BACKLIGHT_SEQUENCE_MAX_LEN);
+}
+
+static void press(uint32_t keycode)
+{
+    raise_key(keycode);
+    run();
+}
+
+static void *setup(void)
+{
+    // init_fixed_brightness() ran at boot and started the first fade
+    run();
+    boot_level = fake_backlight.level;
+    boot_posted_level = fake_brightness_status.level;
+    return NULL;
+}
+
+static void before(void *fixture)
+{
+    // Every test starts with the screen on at the default level and a fresh idle timeout
+    press(KEY_A);
+    zassert_equal(fake_backlight.level, DEFAULT_LEVEL, "a previous test left the screen at %d",
+                  fake_backlight.level);
+}
+
+ZTEST(brightness, test_boot_fades_to_default)
+{
+    zassert_equal(boot_level, DEFAULT_LEVEL);
+    zassert_equal(boot_posted_level, DEFAULT_LEVEL, "the widget didn't get the boot level");
+}
+
+ZTEST(brightness, test_idle_timeout)
+{
+    k_msleep(IDLE_TIMEOUT_MS - 100);
+    run();
+    zassert_equal(fake_backlight.level, DEFAULT_LEVEL, "off before the timeout");
+
+    // Activity restarts the timeout
+    press(KEY_A);
+    k_msleep(IDLE_TIMEOUT_MS - 100);
+    run();
+    zassert_equal(fake_backlight.level, DEFAULT_LEVEL, "activity didn't restart the timeout");
+
+    k_msleep(200);
+    run();
+    zassert_equal(fake_backlight.level, 0, "still on after the timeout");
+
+    // Any key or layer change brings it back
+    raise_layer_change();
+    run();
+    zassert_equal(fake_backlight.level, DEFAULT_LEVEL);
+}
+
+ZTEST(brightness, test_activity_is_coalesced)
+{
+    k_msleep(IDLE_TIMEOUT_MS + 100);
+    run();
+    zassert_equal(fake_backlight.level, 0);
+
+    uint32_t plays = fake_backlight.plays;
+
+    // Far more than the event queue holds, typing only sets a flag
+    for (int i = 0; i < 100; i++)
+    {
+        raise_key(KEY_A);
+        raise_layer_change();
+    }
+    run();
+
+    zassert_equal(fake_backlight.plays, plays + 1, "one burst of typing played %u fades",
+                  fake_backlight.plays - plays);
+    zassert_equal(fake_backlight.level, DEFAULT_LEVEL);
+
+    // With the screen on, typing doesn't touch the backlight at all
+    for (int i = 0; i < 100; i++)
+    {
+        raise_key(KEY_A);
+    }
+    run();
+    zassert_equal(fake_backlight.plays, plays + 1);
+}
+
+ZTEST(brightness, test_modifier_up_down)
+{
+    uint32_t posts = fake_brightness_status.posts;
+
+    press(KEY_UP);
+    zassert_equal(fake_backlight.level, DEFAULT_LEVEL + STEP);
+    zassert_equal(fake_brightness_status.level, DEFAULT_LEVEL + STEP);
+
+    press(KEY_DOWN);
+    press(KEY_DOWN);
+    zassert_equal(fake_backlight.level, DEFAULT_LEVEL - STEP);
+
+    press(KEY_UP);
+    zassert_equal(fake_backlight.level, DEFAULT_LEVEL);
+    zassert_equal(fake_brightness_status.posts, posts + 4, "every step shows the overlay");
+}
+
+ZTEST(brightness, test_modifier_stops_at_max)
+{
+    int ups = (CONFIG_DONGLE_SCREEN_MAX_BRIGHTNESS - DEFAULT_LEVEL) / STEP;
+
+    for (int i = 0; i < ups + 3; i++)
+    {
+        press(KEY_UP);
+    }
+    zassert_equal(fake_backlight.level, CONFIG_DONGLE_SCREEN_MAX_BRIGHTNESS);
+
+    // The presses past the maximum didn't pile up in the modifier
+    for (int i = 0; i < ups; i++)
+    {
+        press(KEY_DOWN);
+    }
+    zassert_equal(fake_backlight.level, DEFAULT_LEVEL);
+}
+
+ZTEST(brightness, test_key_commands_keep_their_order)
+{
+    // Queued before the work queue gets to run once
+    raise_key(KEY_UP);
+    raise_key(KEY_UP);
+    raise_key(KEY_DOWN);
+    run();
+    zassert_equal(fake_backlight.level, DEFAULT_LEVEL + STEP);
+
+    raise_key(KEY_DOWN);
+    raise_key(KEY_DOWN);
+    raise_key(KEY_UP);
+    run();
+    zassert_equal(fake_backlight.level, DEFAULT_LEVEL);
+}
+
+ZTEST(brightness, test_toggle)
+{
+    press(KEY_TOGGLE);
+    zassert_equal(fake_backlight.level, 0);
+
+    // Switched off on purpose, typing doesn't wake it
+    press(KEY_A);
+    zassert_equal(fake_backlight.level, 0, "typing undid the toggle");
+
+    press(KEY_TOGGLE);
+    zassert_equal(fake_backlight.level, DEFAULT_LEVEL);
+}
+
+ZTEST(brightness, test_toggle_then_idle_timeout)
+{
+    press(KEY_TOGGLE);
+    k_msleep(IDLE_TIMEOUT_MS + 100);
+    run();
+    zassert_equal(fake_backlight.level, 0);
+
+    // The timeout ends the toggle, from now on typing wakes the screen again
+    press(KEY_A);
+    zassert_equal(fake_backlight.level, DEFAULT_LEVEL);
+}
+
+ZTEST(brightness, test_reconnect_wakes_screen)
+{
+    uint32_t plays = fake_backlight.plays;
+
+    brightness_wake_screen_on_reconnect();
+    run();
+    zassert_equal(fake_backlight.plays, plays, "reconnect touched a screen that was on");
+
+    k_msleep(IDLE_TIMEOUT_MS + 100);
+    run();
+    zassert_equal(fake_backlight.level, 0);
+
+    brightness_wake_screen_on_reconnect();
+    run();
+    zassert_equal(fake_backlight.level, DEFAULT_LEVEL);
+
+    // And the idle timeout runs again from the reconnect
+    k_msleep(IDLE_TIMEOUT_MS + 100);
+    run();
+    zassert_equal(fake_backlight.level, 0);
+}
+
+ZTEST_SUITE(brightness, NULL, setup, before, NULL, NULL);
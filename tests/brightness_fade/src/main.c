@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+
+#include "brightness_fade.h"
+#include "fake_backlight.h"
+
+// Fade from @p from to @p to with the backlight idle, like a single key press
+static void fade(uint8_t from, uint8_t to)
+{
+    fake_backlight_reset(from);
+    brightness_fade_to(to);
+}
+
+static uint32_t fade_duration_ms(void)
+{
+    return (fake_backlight.count - 1) * fake_backlight.step_us / 1000;
+}
+
+ZTEST(brightness_fade, test_full_fade_is_s_curve)
+{
+    fade(0, 100);
+
+    zassert_equal(fake_backlight.count, BACKLIGHT_SEQUENCE_MAX_LEN);
+    zassert_equal(fake_backlight.levels[0], 0);
+    zassert_equal(fake_backlight.levels[BACKLIGHT_SEQUENCE_MAX_LEN - 1], 100);
+
+    for (size_t i = 1; i < fake_backlight.count; i++)
+    {
+        zassert_true(fake_backlight.levels[i] >= fake_backlight.levels[i - 1], "step %zu goes down", i);
+    }
+
+    // Slow start and end, halfway at half time
+    zassert_true(fake_backlight.levels[8] <= 10, "quarter time at %d", fake_backlight.levels[8]);
+    zassert_within(fake_backlight.levels[16], 50, 1);
+    zassert_true(fake_backlight.levels[24] >= 90, "three quarter time at %d", fake_backlight.levels[24]);
+}
+
+ZTEST(brightness_fade, test_fade_down_mirrors_fade_up)
+{
+    uint8_t up[BACKLIGHT_SEQUENCE_MAX_LEN];
+
+    fade(0, 100);
+    memcpy(up, fake_backlight.levels, sizeof(up));
+    fade(100, 0);
+
+    zassert_equal(fake_backlight.count, BACKLIGHT_SEQUENCE_MAX_LEN);
+    for (size_t i = 0; i < fake_backlight.count; i++)
+    {
+        zassert_within(fake_backlight.levels[i], 100 - up[i], 1, "step %zu", i);
+    }
+}
+
+ZTEST(brightness_fade, test_every_fade_ends_on_target)
+{
+    for (int from = 0; from <= 100; from++)
+    {
+        for (int to = 0; to <= 100; to++)
+        {
+            fade(from, to);
+
+            zassert_true(fake_backlight.count >= 1 && fake_backlight.count <= BACKLIGHT_SEQUENCE_MAX_LEN);
+            zassert_equal(fake_backlight.levels[fake_backlight.count - 1], to, "%d -> %d", from, to);
+
+            for (size_t i = 1; i < fake_backlight.count; i++)
+            {
+                int step = fake_backlight.levels[i] - fake_backlight.levels[i - 1];
+
+                zassert_true(to >= from ? step >= 0 : step <= 0, "%d -> %d overshoots at step %zu", from, to,
+                             i);
+            }
+        }
+    }
+}
+
+ZTEST(brightness_fade, test_tiny_change_is_applied_directly)
+{
+    fade(50, 51);
+
+    zassert_equal(fake_backlight.count, 1);
+    zassert_equal(fake_backlight.level, 51);
+    zassert_false(backlight_busy());
+}
+
+ZTEST(brightness_fade, test_duration_scales_with_distance)
+{
+    fade(0, 10);
+    zassert_equal(fade_duration_ms(), 500);
+
+    fade(20, 60);
+    zassert_equal(fade_duration_ms(), 800);
+
+    fade(0, 100);
+    zassert_equal(fade_duration_ms(), 1000);
+}
+
+/*
+ * native_sim doesn't advance its clock while code runs, so the CPU time of a fade can't be
+ * measured here. The cost is bounded instead: brightness_fade.c is built with
+ * -mgeneral-regs-only, so it can't use float math, and one fade is one table lookup per step.
+ */
+ZTEST(brightness_fade, test_fade_is_one_play)
+{
+    fade(0, 100);
+    zassert_equal(fake_backlight.plays, 1, "a fade must be handed to the backend in one go");
+}
+
+ZTEST_SUITE(brightness_fade, NULL, NULL, NULL, NULL, NULL);
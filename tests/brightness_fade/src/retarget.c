@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/ztest.h>
+
+#include "brightness_fade.h"
+#include "fake_backlight.h"
+
+// Brightness key held down: a new target every few fade steps, before the fade ended
+#define KEY_STEP 10
+#define STEPS_PER_REPEAT 3
+
+// Retarget to @p to and play @p steps of the new fade, checking the output never reverses
+static void repeat_to(uint8_t to, size_t steps, int direction)
+{
+    uint8_t before = backlight_get();
+
+    brightness_fade_to(to);
+    zassert_equal(backlight_get(), before, "retargeting to %d jumped from %d to %d", to, before,
+                  backlight_get());
+
+    for (size_t i = 0; i < steps; i++)
+    {
+        uint8_t last = backlight_get();
+
+        fake_backlight_advance(1);
+        zassert_true((backlight_get() - last) * direction >= 0, "fade to %d went from %d back to %d", to,
+                     last, backlight_get());
+    }
+}
+
+ZTEST(brightness_fade_retarget, test_key_repeat_up_is_monotonic)
+{
+    fake_backlight_reset(0);
+
+    for (int to = KEY_STEP; to <= 100; to += KEY_STEP)
+    {
+        repeat_to(to, STEPS_PER_REPEAT, 1);
+    }
+
+    // Key released, the last fade runs to its end
+    repeat_to(100, BACKLIGHT_SEQUENCE_MAX_LEN, 1);
+    zassert_equal(backlight_get(), 100);
+    zassert_false(backlight_busy());
+}
+
+ZTEST(brightness_fade_retarget, test_key_repeat_down_is_monotonic)
+{
+    fake_backlight_reset(100);
+
+    for (int to = 100 - KEY_STEP; to >= 0; to -= KEY_STEP)
+    {
+        repeat_to(to, STEPS_PER_REPEAT, -1);
+    }
+
+    repeat_to(0, BACKLIGHT_SEQUENCE_MAX_LEN, -1);
+    zassert_equal(backlight_get(), 0);
+}
+
+ZTEST(brightness_fade_retarget, test_reversal_continues_from_current_level)
+{
+    fake_backlight_reset(20);
+    brightness_fade_to(80);
+    fake_backlight_advance(16);
+
+    uint8_t turn = backlight_get();
+
+    zassert_true(turn > 20 && turn < 80);
+    repeat_to(10, BACKLIGHT_SEQUENCE_MAX_LEN, -1);
+    zassert_equal(backlight_get(), 10);
+}
+
+ZTEST(brightness_fade_retarget, test_retarget_keeps_speed)
+{
+    fake_backlight_reset(0);
+    brightness_fade_to(100);
+    uint32_t us_per_level = (fake_backlight.count - 1) * fake_backlight.step_us / 100;
+
+    fake_backlight_advance(8);
+    uint8_t from = backlight_get();
+
+    brightness_fade_to(from + 50);
+
+    uint32_t duration_us = (fake_backlight.count - 1) * fake_backlight.step_us;
+
+    // Half the distance at the same speed, up to the rounding of the step length
+    zassert_within(duration_us, 50 * us_per_level, fake_backlight.count, "retarget took %u us", duration_us);
+}
+
+ZTEST_SUITE(brightness_fade_retarget, NULL, NULL, NULL, NULL, NULL);
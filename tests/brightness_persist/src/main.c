@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/settings/settings.h>
+#include <zmk/events/keycode_state_changed.h>
+
+#include "fake_backlight.h"
+
+extern const struct zmk_listener zmk_listener_screen_idle;
+
+#define DEFAULT_LEVEL CONFIG_DONGLE_SCREEN_DEFAULT_BRIGHTNESS
+#define STEP CONFIG_DONGLE_SCREEN_BRIGHTNESS_STEP
+#define DEBOUNCE_MS CONFIG_ZMK_SETTINGS_SAVE_DEBOUNCE
+
+#define KEY_UP CONFIG_DONGLE_SCREEN_BRIGHTNESS_UP_KEYCODE
+#define KEY_DOWN CONFIG_DONGLE_SCREEN_BRIGHTNESS_DOWN_KEYCODE
+
+// Same layout as in brightness.c
+struct brightness_state
+{
+    int8_t brightness;
+    int8_t modifier;
+};
+
+// Settings backend that starts empty and counts the writes instead of touching flash
+static uint32_t saves;
+static char stored_name[32];
+static struct brightness_state stored;
+
+static int counting_load(struct settings_store *cs, const struct settings_load_arg *arg)
+{
+    return 0;
+}
+
+static int counting_save(struct settings_store *cs, const char *name, const char *value, size_t val_len)
+{
+    strncpy(stored_name, name, sizeof(stored_name) - 1);
+    memcpy(&stored, value, MIN(val_len, sizeof(stored)));
+    saves++;
+    return 0;
+}
+
+static const struct settings_store_itf counting_itf = {
+    .csi_load = counting_load,
+    .csi_save = counting_save,
+};
+
+static struct settings_store counting_store = {.cs_itf = &counting_itf};
+
+int settings_backend_init(void)
+{
+    settings_src_register(&counting_store);
+    settings_dst_register(&counting_store);
+    return 0;
+}
+
+// The modifier the presses so far add up to
+static int8_t modifier = CONFIG_DONGLE_SCREEN_BRIGHTNESS_MODIFIER;
+
+static void press(uint32_t keycode)
+{
+    struct zmk_keycode_state_changed_event ev = {
+        .header = {.event = &zmk_event_zmk_keycode_state_changed},
+        .data = {.keycode = keycode, .state = true},
+    };
+
+    zmk_listener_screen_idle.callback(&ev.header);
+    modifier += keycode == KEY_UP ? STEP : -STEP;
+
+    // Let the brightness work queue handle it and play the fade to the end
+    k_msleep(1);
+    fake_backlight_advance(BACKLIGHT_SEQUENCE_MAX_LEN);
+}
+
+static void before(void *fixture)
+{
+    // Let a save a previous test left pending happen
+    k_msleep(DEBOUNCE_MS + 100);
+}
+
+ZTEST(brightness_persist, test_burst_is_one_write)
+{
+    uint32_t saves_before = saves;
+
+    press(KEY_UP);
+    press(KEY_UP);
+    press(KEY_DOWN);
+    k_msleep(DEBOUNCE_MS / 2);
+    zassert_equal(saves, saves_before, "saved within the debounce time");
+
+    // Every press restarts the debounce
+    press(KEY_UP);
+    k_msleep(DEBOUNCE_MS - 100);
+    zassert_equal(saves, saves_before);
+
+    k_msleep(200);
+    zassert_equal(saves, saves_before + 1, "%u writes for one burst", saves - saves_before);
+    zassert_equal(stored.modifier, modifier);
+}
+
+ZTEST(brightness_persist, test_back_and_forth_is_no_write)
+{
+    // Make sure there is a saved state to come back to
+    press(KEY_UP);
+    k_msleep(DEBOUNCE_MS + 100);
+
+    uint32_t saves_before = saves;
+    struct brightness_state saved = stored;
+
+    press(KEY_UP);
+    press(KEY_DOWN);
+    press(KEY_DOWN);
+    press(KEY_UP);
+    k_msleep(DEBOUNCE_MS + 100);
+
+    zassert_equal(modifier, saved.modifier);
+    zassert_equal(saves, saves_before, "wrote the state it already had");
+}
+
+ZTEST(brightness_persist, test_saved_brightness)
+{
+    press(KEY_UP);
+    k_msleep(DEBOUNCE_MS + 100);
+
+    // Without the sensor the keys only move the modifier, with it the room brightness isn't
+    // saved, so in both cases the record keeps the default
+    zassert_equal(strcmp(stored_name, "dongle_screen/state"), 0);
+    zassert_equal(stored.brightness, DEFAULT_LEVEL);
+    zassert_equal(stored.modifier, modifier);
+
+    if (IS_ENABLED(CONFIG_DONGLE_SCREEN_AMBIENT_LIGHT))
+    {
+        zassert_not_equal(fake_backlight.level, DEFAULT_LEVEL + modifier,
+                          "the room brightness happens to be the default, the test proves nothing");
+    }
+}
+
+ZTEST_SUITE(brightness_persist, NULL, NULL, before, NULL, NULL);
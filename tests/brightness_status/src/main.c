@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/ztest.h>
+#include <lvgl.h>
+#include <lvgl_mem.h>
+
+#include "widgets/brightness_status.h"
+
+// Key repeat of a held brightness key
+#define KEY_REPEAT_MS 30
+#define HIDE_DELAY_MS 500
+
+static struct zmk_widget_brightness_status widget;
+
+static uint32_t timer_count(void)
+{
+    uint32_t count = 0;
+
+    for (lv_timer_t *timer = lv_timer_get_next(NULL); timer; timer = lv_timer_get_next(timer))
+    {
+        count++;
+    }
+    return count;
+}
+
+static size_t heap_used(void)
+{
+    struct sys_memory_stats stats;
+
+    lvgl_heap_stats(&stats);
+    return stats.allocated_bytes;
+}
+
+static void *setup(void)
+{
+    zmk_widget_brightness_status_init(&widget, lv_screen_active());
+    return NULL;
+}
+
+static void before(void *fixture)
+{
+    // Start every test with the overlay hidden again
+    k_msleep(HIDE_DELAY_MS + 10);
+    lv_timer_handler();
+}
+
+ZTEST(brightness_status, test_hammering_keeps_heap_and_timers_constant)
+{
+    // One full up/down cycle first, so the label buffer has grown to its largest size
+    for (int level = 0; level <= 100; level++)
+    {
+        zmk_widget_update_brightness_status(&widget, level);
+    }
+
+    uint32_t timers = timer_count();
+    size_t heap = heap_used();
+
+    for (int round = 0; round < 20; round++)
+    {
+        for (int level = 0; level <= 100; level += 5)
+        {
+            zmk_widget_update_brightness_status(&widget, level);
+            lv_timer_handler();
+        }
+        for (int level = 100; level >= 0; level -= 5)
+        {
+            zmk_widget_update_brightness_status(&widget, level);
+            lv_timer_handler();
+        }
+    }
+    zmk_widget_update_brightness_status(&widget, 100);
+
+    zassert_equal(timer_count(), timers, "brightness updates created timers");
+    zassert_equal(heap_used(), heap, "brightness updates leaked LVGL heap");
+}
+
+ZTEST(brightness_status, test_repeated_level_is_not_redrawn)
+{
+    uint32_t updates = zmk_widget_brightness_status_update_count();
+
+    zmk_widget_update_brightness_status(&widget, 42);
+    // Unhiding and the new text
+    zassert_equal(zmk_widget_brightness_status_update_count(), updates + 2);
+
+    for (int i = 0; i < 50; i++)
+    {
+        zmk_widget_update_brightness_status(&widget, 42);
+    }
+    zassert_equal(zmk_widget_brightness_status_update_count(), updates + 2,
+                  "unchanged brightness touched LVGL");
+}
+
+ZTEST(brightness_status, test_key_repeat_hides_once)
+{
+    // A held key keeps pushing the hide out, the overlay must not flicker in between
+    for (int i = 0; i < 40; i++)
+    {
+        zmk_widget_update_brightness_status(&widget, 10 + i);
+        k_msleep(KEY_REPEAT_MS);
+        lv_timer_handler();
+        zassert_false(lv_obj_has_flag(widget.obj, LV_OBJ_FLAG_HIDDEN), "hidden during key repeat");
+    }
+
+    k_msleep(HIDE_DELAY_MS + 10);
+    lv_timer_handler();
+    zassert_true(lv_obj_has_flag(widget.obj, LV_OBJ_FLAG_HIDDEN));
+
+    // The paused timer doesn't fire again
+    uint32_t updates = zmk_widget_brightness_status_update_count();
+
+    k_msleep(HIDE_DELAY_MS * 2);
+    lv_timer_handler();
+    zassert_equal(zmk_widget_brightness_status_update_count(), updates);
+    zassert_true(lv_obj_has_flag(widget.obj, LV_OBJ_FLAG_HIDDEN));
+}
+
+ZTEST_SUITE(brightness_status, NULL, setup, before, NULL, NULL);
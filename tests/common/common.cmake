@@ -0,0 +1,15 @@
+# Copyright (c) 2025 The ZMK Contributors
+# SPDX-License-Identifier: MIT
+
+# Builds module sources for native_sim without ZMK. Include after find_package(Zephyr).
+
+set(TESTS_COMMON_DIR ${CMAKE_CURRENT_LIST_DIR})
+set(DONGLE_SCREEN_DIR ${CMAKE_CURRENT_LIST_DIR}/../../boards/shields/dongle_screen)
+set(DONGLE_SCREEN_SRC ${DONGLE_SCREEN_DIR}/src)
+
+target_include_directories(app PRIVATE
+  ${CMAKE_CURRENT_LIST_DIR}/include
+  ${DONGLE_SCREEN_SRC}
+  ${DONGLE_SCREEN_DIR}/include
+)
+target_sources(app PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/zmk_stubs.c)
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "backlight.h"
+
+// Backlight backend that records the sequences instead of driving a PWM. Tests that use it add
+// ${TESTS_COMMON_DIR}/src/fake_backlight.c to their sources.
+
+struct fake_backlight
+{
+    uint8_t levels[BACKLIGHT_SEQUENCE_MAX_LEN];
+    size_t count;     // Length of the last played sequence
+    size_t played;    // Steps of it already applied
+    uint32_t step_us;
+    uint8_t level;    // Level currently applied
+    uint32_t plays;   // backlight_play() calls
+    uint32_t updates; // Level changes applied, reported as backlight_update_count()
+};
+
+extern struct fake_backlight fake_backlight;
+
+void fake_backlight_reset(uint8_t level);
+
+// Apply the next @p steps levels of the running sequence
+void fake_backlight_advance(size_t steps);
@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// Records what brightness.c hands to the brightness widget, for the tests that build
+// brightness.c without the widget. They add ${TESTS_COMMON_DIR}/src/fake_brightness_status.c
+// to their sources. The overlay itself is tested in brightness_status.
+
+struct fake_brightness_status
+{
+    uint8_t level; // Last posted level
+    uint32_t posts;
+};
+
+extern struct fake_brightness_status fake_brightness_status;
@@ -0,0 +1,15 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zmk/keymap.h>
+
+// Keymap of ZMK_KEYMAP_LAYERS_LEN named layers in id order. Tests that use it add
+// ${TESTS_COMMON_DIR}/src/fake_keymap.c to their sources.
+
+// Returned by zmk_keymap_highest_layer_active()
+extern zmk_keymap_layer_id_t fake_keymap_highest_layer;
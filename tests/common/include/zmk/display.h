@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/* Stand-in for ZMK's display API in the native_sim tests */
+
+#pragma once
+
+#include <stdbool.h>
+#include <zephyr/kernel.h>
+#include <zmk/event_manager.h>
+
+struct k_work_q *zmk_display_work_q(void);
+bool zmk_display_is_initialized(void);
+
+// Same flow as ZMK's: the state is taken in the event context, the widgets are updated from the
+// display work queue. The state is only touched from the test and the work queue, no mutex.
+#define ZMK_DISPLAY_WIDGET_LISTENER(listener, state_type, cb, state_func)                          \
+    static state_type __##listener##_state;                                                        \
+    static state_type listener##_get_local_state(void)                                             \
+    {                                                                                              \
+        return __##listener##_state;                                                               \
+    }                                                                                              \
+    static void listener##_refresh(struct k_work *work)                                            \
+    {                                                                                              \
+        cb(listener##_get_local_state());                                                          \
+    }                                                                                              \
+    K_WORK_DEFINE(listener##_work, listener##_refresh);                                            \
+    static void listener##_init(void)                                                              \
+    {                                                                                              \
+        __##listener##_state = state_func(NULL);                                                   \
+        listener##_refresh(NULL);                                                                  \
+    }                                                                                              \
+    static int listener##_cb(const zmk_event_t *eh)                                                \
+    {                                                                                              \
+        if (zmk_display_is_initialized())                                                          \
+        {                                                                                          \
+            __##listener##_state = state_func(eh);                                                 \
+            k_work_submit_to_queue(zmk_display_work_q(), &listener##_work);                        \
+        }                                                                                          \
+        return ZMK_EV_EVENT_BUBBLE;                                                                \
+    }                                                                                              \
+    ZMK_LISTENER(listener, listener##_cb);
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/* Stand-in for ZMK's event manager in the native_sim tests */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+struct zmk_event_type
+{
+    const char *name;
+};
+
+typedef struct
+{
+    const struct zmk_event_type *event;
+} zmk_event_t;
+
+#define ZMK_EV_EVENT_BUBBLE 0
+
+struct zmk_listener
+{
+    int (*callback)(const zmk_event_t *eh);
+};
+
+// An event is its header followed by the data, as_<type>() returns the data of a matching event
+#define ZMK_EVENT_DECLARE(event_type)                                                              \
+    struct event_type##_event                                                                      \
+    {                                                                                              \
+        zmk_event_t header;                                                                        \
+        struct event_type data;                                                                    \
+    };                                                                                             \
+    extern const struct zmk_event_type zmk_event_##event_type;                                     \
+    static inline struct event_type *as_##event_type(const zmk_event_t *eh)                        \
+    {                                                                                              \
+        return eh && eh->event == &zmk_event_##event_type                                          \
+                   ? &((struct event_type##_event *)eh)->data                                      \
+                   : NULL;                                                                         \
+    }                                                                                              \
+    extern const struct zmk_event_type zmk_event_##event_type
+
+// Defined once by the test that raises the event
+#define ZMK_EVENT_IMPL(event_type)                                                                 \
+    const struct zmk_event_type zmk_event_##event_type = {.name = #event_type}
+
+// Tests call zmk_listener_<mod>.callback() directly, subscriptions aren't tracked
+#define ZMK_LISTENER(mod, cb) const struct zmk_listener zmk_listener_##mod = {.callback = cb}
+#define ZMK_SUBSCRIPTION(mod, ev_type) extern const struct zmk_listener zmk_listener_##mod
@@ -0,0 +1,16 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zmk/event_manager.h>
+
+struct zmk_wpm_state_changed
+{
+    int state;
+};
+
+ZMK_EVENT_DECLARE(zmk_wpm_state_changed);
@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/* Stand-in for ZMK's keymap API in the native_sim tests, served by src/fake_keymap.c */
+
+#pragma once
+
+#include <stdint.h>
+
+#define ZMK_KEYMAP_LAYERS_LEN 4
+#define ZMK_KEYMAP_LAYER_ID_INVAL UINT8_MAX
+
+typedef uint8_t zmk_keymap_layer_id_t;
+typedef uint8_t zmk_keymap_layer_index_t;
+
+zmk_keymap_layer_id_t zmk_keymap_layer_index_to_id(zmk_keymap_layer_index_t layer_index);
+const char *zmk_keymap_layer_name(zmk_keymap_layer_id_t layer_id);
+zmk_keymap_layer_id_t zmk_keymap_highest_layer_active(void);
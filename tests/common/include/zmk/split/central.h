@@ -0,0 +1,10 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+// Stand-in for ZMK's split central header, the tests run with two peripherals
+#define ZMK_SPLIT_CENTRAL_PERIPHERAL_COUNT 2
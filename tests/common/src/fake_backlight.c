@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+
+#include "fake_backlight.h"
+
+struct fake_backlight fake_backlight;
+
+void fake_backlight_reset(uint8_t level)
+{
+    fake_backlight = (struct fake_backlight){.level = level};
+}
+
+void fake_backlight_advance(size_t steps)
+{
+    while (steps-- > 0 && fake_backlight.played < fake_backlight.count)
+    {
+        uint8_t level = fake_backlight.levels[fake_backlight.played++];
+
+        fake_backlight.updates += level != fake_backlight.level;
+        fake_backlight.level = level;
+    }
+}
+
+int backlight_play(const uint8_t *levels, size_t count, uint32_t step_us)
+{
+    if (count == 0 || count > BACKLIGHT_SEQUENCE_MAX_LEN)
+    {
+        return -EINVAL;
+    }
+
+    memcpy(fake_backlight.levels, levels, count);
+    fake_backlight.count = count;
+    fake_backlight.step_us = step_us;
+    fake_backlight.plays++;
+
+    // Like the real backend, the first level is applied right away
+    fake_backlight.played = 0;
+    fake_backlight_advance(1);
+    return 0;
+}
+
+int backlight_set(uint8_t level)
+{
+    return backlight_play(&level, 1, 0);
+}
+
+uint8_t backlight_get(void)
+{
+    return fake_backlight.level;
+}
+
+bool backlight_busy(void)
+{
+    return fake_backlight.played < fake_backlight.count;
+}
+
+uint32_t backlight_update_count(void)
+{
+    return fake_backlight.updates;
+}
@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+
+#include "fake_brightness_status.h"
+#include "widgets/brightness_status.h"
+
+struct fake_brightness_status fake_brightness_status;
+
+void zmk_widget_brightness_status_post(uint8_t brightness)
+{
+    fake_brightness_status.level = brightness;
+    fake_brightness_status.posts++;
+}
+
+uint32_t zmk_widget_brightness_status_update_count(void)
+{
+    return fake_brightness_status.posts;
+}
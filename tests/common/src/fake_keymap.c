@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/sys/util.h>
+
+#include "fake_keymap.h"
+
+static const char *const layer_names[ZMK_KEYMAP_LAYERS_LEN] = {"Base", "Nav", "Sym", "Fn"};
+
+zmk_keymap_layer_id_t fake_keymap_highest_layer;
+
+zmk_keymap_layer_id_t zmk_keymap_layer_index_to_id(zmk_keymap_layer_index_t layer_index)
+{
+    return layer_index < ARRAY_SIZE(layer_names) ? layer_index : ZMK_KEYMAP_LAYER_ID_INVAL;
+}
+
+const char *zmk_keymap_layer_name(zmk_keymap_layer_id_t layer_id)
+{
+    return layer_id < ARRAY_SIZE(layer_names) ? layer_names[layer_id] : NULL;
+}
+
+zmk_keymap_layer_id_t zmk_keymap_highest_layer_active(void)
+{
+    return fake_keymap_highest_layer;
+}
@@ -0,0 +1,12 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zmk/events/keycode_state_changed.h>
+#include <zmk/events/layer_state_changed.h>
+
+// The events brightness.c listens to, raised by the tests that build it
+ZMK_EVENT_IMPL(zmk_keycode_state_changed);
+ZMK_EVENT_IMPL(zmk_layer_state_changed);
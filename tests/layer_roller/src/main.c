@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/ztest.h>
+#include <lvgl.h>
+#include <zmk/events/layer_state_changed.h>
+
+#include "fake_keymap.h"
+#include "widgets/layer_roller.h"
+
+extern const struct zmk_listener zmk_listener_widget_layer_roller;
+
+// Longer than the roller's scroll animation
+#define SCROLL_MS 600
+
+// What LVGL did for one layer change
+struct redraw_stats
+{
+    uint32_t frames; // Refreshes that had something to render
+    uint32_t areas;  // Areas marked for redraw
+    uint32_t pixels; // Their total size, overlapping ones counted twice
+    lv_area_t bounds;
+};
+
+static struct redraw_stats stats;
+static struct zmk_widget_layer_roller roller;
+
+static void count_invalidation(lv_event_t *e)
+{
+    const lv_area_t *area = lv_event_get_param(e);
+
+    if (stats.areas == 0)
+    {
+        stats.bounds = *area;
+    }
+    else
+    {
+        lv_area_join(&stats.bounds, &stats.bounds, area);
+    }
+    stats.areas++;
+    stats.pixels += lv_area_get_size(area);
+}
+
+static void count_frame(lv_event_t *e)
+{
+    stats.frames++;
+}
+
+// Let the display work queue apply the event, then run LVGL until the scroll ended
+static void show_layer(zmk_keymap_layer_id_t layer)
+{
+    struct zmk_layer_state_changed_event ev = {
+        .header = {.event = &zmk_event_zmk_layer_state_changed},
+        .data = {.layer = layer, .state = true},
+    };
+
+    fake_keymap_highest_layer = layer;
+    stats = (struct redraw_stats){0};
+    zmk_listener_widget_layer_roller.callback(&ev.header);
+
+    for (int ms = 0; ms < SCROLL_MS; ms += LV_DEF_REFR_PERIOD)
+    {
+        k_msleep(LV_DEF_REFR_PERIOD);
+        lv_timer_handler();
+    }
+}
+
+static void *setup(void)
+{
+    lv_display_t *display = lv_display_get_default();
+
+    lv_display_add_event_cb(display, count_invalidation, LV_EVENT_INVALIDATE_AREA, NULL);
+    lv_display_add_event_cb(display, count_frame, LV_EVENT_RENDER_START, NULL);
+
+    // Sized and placed like a layout tile, away from the screen edges
+    zmk_widget_layer_roller_init(&roller, lv_screen_active());
+    lv_obj_set_size(roller.obj, 240, 120);
+    lv_obj_set_pos(roller.obj, 0, 80);
+    lv_refr_now(NULL);
+    return NULL;
+}
+
+static void before(void *fixture)
+{
+    show_layer(0);
+}
+
+ZTEST(layer_roller, test_change_redraws_roller_only)
+{
+    lv_area_t coords;
+
+    show_layer(2);
+    lv_obj_get_coords(roller.obj, &coords);
+
+    zassert_equal(lv_roller_get_selected(roller.obj), 2);
+    zassert_true(stats.frames > 0);
+    zassert_true(lv_area_is_in(&stats.bounds, &coords, 0), "redraw reached outside the roller");
+
+    TC_PRINT("Layer change, fade %s: %u frames, %u areas, %u pixels (roller %u)\n",
+             IS_ENABLED(CONFIG_DONGLE_SCREEN_LAYER_ROLLER_FADE) ? "on" : "off", stats.frames,
+             stats.areas, stats.pixels, lv_area_get_size(&coords));
+}
+
+ZTEST(layer_roller, test_idle_after_scroll)
+{
+    show_layer(1);
+
+    // The fade overlays are static, once the scroll ended nothing is redrawn
+    stats = (struct redraw_stats){0};
+    for (int i = 0; i < 10; i++)
+    {
+        k_msleep(LV_DEF_REFR_PERIOD);
+        lv_timer_handler();
+    }
+    zassert_equal(stats.areas, 0, "%u areas redrawn with nothing changing", stats.areas);
+    zassert_equal(stats.frames, 0);
+}
+
+ZTEST(layer_roller, test_same_layer_is_free)
+{
+    show_layer(0);
+    zassert_equal(stats.areas, 0, "repeating the layer redrew %u areas", stats.areas);
+    zassert_equal(stats.frames, 0);
+}
+
+ZTEST_SUITE(layer_roller, NULL, setup, before, NULL, NULL);
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/ztest.h>
+#include <lvgl.h>
+#include <lvgl_mem.h>
+
+#include "lvgl_monitor.h"
+
+static void noop_timer_cb(lv_timer_t *timer)
+{
+}
+
+ZTEST(lvgl_monitor, test_sample_leaves_heap_untouched)
+{
+    struct dongle_screen_lvgl_stats first, second;
+    struct sys_memory_stats before, after;
+
+    lvgl_heap_stats(&before);
+    dongle_screen_lvgl_monitor_sample(&first);
+    dongle_screen_lvgl_monitor_sample(&second);
+    lvgl_heap_stats(&after);
+
+    zassert_equal(first.used_bytes, second.used_bytes);
+    // Any allocation made while sampling would have raised the high watermark
+    zassert_equal(before.max_allocated_bytes, after.max_allocated_bytes,
+                  "sampling allocated from the heap it measures");
+}
+
+ZTEST(lvgl_monitor, test_counts_objects_and_timers)
+{
+    struct dongle_screen_lvgl_stats before, after;
+
+    dongle_screen_lvgl_monitor_sample(&before);
+
+    lv_obj_t *cont = lv_obj_create(lv_screen_active());
+    lv_label_create(cont);
+    lv_bar_create(cont);
+    lv_timer_t *timer = lv_timer_create(noop_timer_cb, 1000, NULL);
+
+    dongle_screen_lvgl_monitor_sample(&after);
+
+    zassert_equal(after.obj_count, before.obj_count + 3);
+    zassert_equal(after.timer_count, before.timer_count + 1);
+    zassert_true(after.used_bytes > before.used_bytes);
+
+    lv_timer_delete(timer);
+    lv_obj_delete(cont);
+}
+
+/*
+ * Same kinds and numbers of objects as the status page: layer roller, battery bars with
+ * labels, WPM bar and label, output and modifier labels, HID indicator labels and the
+ * brightness overlay. Fails when that no longer fits the budget.
+ */
+ZTEST(lvgl_monitor, test_status_screen_within_budget)
+{
+    struct dongle_screen_lvgl_stats stats;
+    lv_obj_t *screen = lv_obj_create(lv_screen_active());
+
+    lv_obj_t *roller = lv_roller_create(screen);
+    lv_roller_set_options(roller, "BASE\nLOWER\nRAISE\nADJUST\nGAME\nNUM", LV_ROLLER_MODE_NORMAL);
+    lv_obj_create(roller);
+    lv_obj_create(roller);
+
+    for (int i = 0; i < 3; i++)
+    {
+        lv_obj_t *bar = lv_bar_create(screen);
+        lv_label_set_text(lv_label_create(bar), "100 12h");
+    }
+
+    lv_obj_t *wpm = lv_obj_create(screen);
+    lv_bar_create(wpm);
+    lv_label_set_text(lv_label_create(wpm), "Words per Minute");
+
+    lv_obj_t *output = lv_obj_create(screen);
+    lv_label_set_text(lv_label_create(output), LV_SYMBOL_USB);
+    lv_label_set_text(lv_label_create(output), "1");
+
+    lv_obj_t *mods = lv_obj_create(screen);
+    lv_label_set_text(lv_label_create(mods), "");
+
+    lv_obj_t *hid = lv_obj_create(screen);
+    for (int i = 0; i < 6; i++)
+    {
+        lv_label_set_text(lv_label_create(hid), "CAP");
+    }
+
+    lv_obj_t *overlay = lv_obj_create(lv_layer_top());
+    lv_label_set_text(lv_label_create(overlay), "100%");
+    lv_timer_t *hide_timer = lv_timer_create(noop_timer_cb, 500, NULL);
+
+    lv_timer_handler();
+    dongle_screen_lvgl_monitor_sample(&stats);
+
+    zassert_true(dongle_screen_lvgl_monitor_within_budget(&stats),
+                 "status screen uses %zu bytes of LVGL heap, budget is %d", stats.used_bytes,
+                 CONFIG_DONGLE_SCREEN_LVGL_HEAP_BUDGET);
+
+    lv_timer_delete(hide_timer);
+    lv_obj_delete(overlay);
+    lv_obj_delete(screen);
+}
+
+ZTEST_SUITE(lvgl_monitor, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/ztest.h>
+#include <lvgl.h>
+
+#include "widgets/brightness_status.h"
+#include "widgets/retained.h"
+
+// Every area LVGL marks for redraw passes through LV_EVENT_INVALIDATE_AREA of the display
+static uint32_t invalidations;
+
+static lv_obj_t *label;
+static struct zmk_widget_brightness_status brightness;
+
+static void count_invalidation(lv_event_t *e)
+{
+    invalidations++;
+}
+
+static void *setup(void)
+{
+    lv_display_add_event_cb(lv_display_get_default(), count_invalidation, LV_EVENT_INVALIDATE_AREA, NULL);
+
+    label = lv_label_create(lv_screen_active());
+    lv_label_set_text(label, "CAP");
+    zmk_widget_brightness_status_init(&brightness, lv_screen_active());
+    return NULL;
+}
+
+static void before(void *fixture)
+{
+    // Draw what earlier tests changed, then count from zero
+    lv_refr_now(NULL);
+    invalidations = 0;
+}
+
+ZTEST(retained, test_label_text)
+{
+    zassert_false(retained_label_set_text(label, "CAP"));
+    zassert_equal(invalidations, 0, "unchanged text invalidated %u areas", invalidations);
+
+    zassert_true(retained_label_set_text(label, "NUM"));
+    zassert_true(invalidations > 0);
+
+    retained_label_set_text(label, "CAP");
+}
+
+ZTEST(retained, test_styles)
+{
+    lv_color_t green = lv_palette_main(LV_PALETTE_GREEN);
+
+    retained_set_text_color(label, green, LV_PART_MAIN);
+    retained_set_bg_color(label, green, LV_PART_MAIN);
+    retained_set_border_color(label, green, LV_PART_MAIN);
+    retained_set_text_font(label, &lv_font_montserrat_40, LV_PART_MAIN);
+    lv_refr_now(NULL);
+    invalidations = 0;
+
+    zassert_false(retained_set_text_color(label, green, LV_PART_MAIN));
+    zassert_false(retained_set_bg_color(label, green, LV_PART_MAIN));
+    zassert_false(retained_set_border_color(label, green, LV_PART_MAIN));
+    zassert_false(retained_set_text_font(label, &lv_font_montserrat_40, LV_PART_MAIN));
+    zassert_equal(invalidations, 0, "unchanged styles invalidated %u areas", invalidations);
+
+    zassert_true(retained_set_text_color(label, lv_palette_main(LV_PALETTE_INDIGO), LV_PART_MAIN));
+    zassert_true(invalidations > 0);
+}
+
+ZTEST(retained, test_visibility)
+{
+    zassert_false(retained_set_hidden(label, false));
+    zassert_equal(invalidations, 0);
+
+    zassert_true(retained_set_hidden(label, true));
+    zassert_true(invalidations > 0);
+    lv_refr_now(NULL);
+    invalidations = 0;
+
+    // Hiding a hidden object again costs nothing either
+    zassert_false(retained_set_hidden(label, true));
+    zassert_equal(invalidations, 0);
+
+    retained_set_hidden(label, false);
+}
+
+// A widget event that repeats the applied state must not redraw anything
+ZTEST(retained, test_repeated_event)
+{
+    zmk_widget_update_brightness_status(&brightness, 40);
+    lv_refr_now(NULL);
+    invalidations = 0;
+
+    for (int i = 0; i < 10; i++)
+    {
+        zmk_widget_update_brightness_status(&brightness, 40);
+    }
+    zassert_equal(invalidations, 0, "10 repeated events invalidated %u areas", invalidations);
+
+    // A new value only redraws the overlay
+    zmk_widget_update_brightness_status(&brightness, 50);
+    zassert_true(invalidations > 0);
+    TC_PRINT("Brightness event: %u invalidated areas\n", invalidations);
+}
+
+ZTEST_SUITE(retained, NULL, setup, before, NULL, NULL);
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/ztest.h>
+#include <lvgl.h>
+#include <zmk/events/wpm_state_changed.h>
+
+#include "widgets/wpm_status.h"
+
+ZMK_EVENT_IMPL(zmk_wpm_state_changed);
+
+extern const struct zmk_listener zmk_listener_widget_wpm_status;
+
+#define INTERVAL_MS CONFIG_DONGLE_SCREEN_WPM_SPARKLINE_INTERVAL_MS
+#define RIGHT_EDGE (WPM_CHART_WIDTH - 1)
+#define WPM_MAX 160
+
+static struct zmk_widget_wpm_status widget;
+
+static void raise_wpm(int wpm)
+{
+    struct zmk_wpm_state_changed_event ev = {
+        .header = {.event = &zmk_event_zmk_wpm_state_changed},
+        .data = {.state = wpm},
+    };
+
+    zmk_listener_widget_wpm_status.callback(&ev.header);
+}
+
+// Row of the line in column @p x of the chart, WPM_CHART_HEIGHT for an empty column
+static int column_top(int x)
+{
+    uint32_t stride = lv_draw_buf_width_to_stride(WPM_CHART_WIDTH, LV_COLOR_FORMAT_A8);
+
+    for (int y = 0; y < WPM_CHART_HEIGHT; y++)
+    {
+        if (widget.chart_buf[y * stride + x] == LV_OPA_COVER)
+        {
+            return y;
+        }
+    }
+    return WPM_CHART_HEIGHT;
+}
+
+static int expected_top(int wpm)
+{
+    return WPM_CHART_HEIGHT - DIV_ROUND_UP(wpm * WPM_CHART_HEIGHT, WPM_MAX);
+}
+
+static void *setup(void)
+{
+    zmk_widget_wpm_status_init(&widget, lv_screen_active());
+    return NULL;
+}
+
+static void before(void *fixture)
+{
+    // Zero until the chart is empty and the sampling stopped
+    raise_wpm(0);
+    k_msleep((WPM_CHART_WIDTH + 2) * INTERVAL_MS);
+}
+
+ZTEST(wpm_status, test_right_edge_is_last_sample)
+{
+    raise_wpm(80);
+    k_msleep(INTERVAL_MS + 10);
+    zassert_equal(column_top(RIGHT_EDGE), expected_top(80));
+    zassert_equal(column_top(RIGHT_EDGE - 1), WPM_CHART_HEIGHT);
+
+    // Several events within one interval, only the latest is sampled
+    raise_wpm(40);
+    raise_wpm(120);
+    k_msleep(INTERVAL_MS);
+    zassert_equal(column_top(RIGHT_EDGE), expected_top(120));
+    zassert_equal(column_top(RIGHT_EDGE - 1), expected_top(80));
+    zassert_equal(column_top(RIGHT_EDGE - 2), WPM_CHART_HEIGHT);
+}
+
+ZTEST(wpm_status, test_sampled_without_events)
+{
+    raise_wpm(60);
+    k_msleep(INTERVAL_MS + 10);
+
+    uint32_t samples = widget.chart_samples;
+
+    // ZMK doesn't report a steady speed again, the chart still moves on
+    k_msleep(3 * INTERVAL_MS);
+    zassert_equal(widget.chart_samples, samples + 3);
+    for (int i = 0; i < 4; i++)
+    {
+        zassert_equal(column_top(RIGHT_EDGE - i), expected_top(60));
+    }
+}
+
+ZTEST(wpm_status, test_sampling_stops_when_empty)
+{
+    raise_wpm(100);
+    k_msleep(INTERVAL_MS + 10);
+    raise_wpm(0);
+
+    // The non-zero column still has to scroll out
+    k_msleep(WPM_CHART_WIDTH * INTERVAL_MS);
+    zassert_equal(column_top(0), WPM_CHART_HEIGHT);
+
+    uint32_t samples = widget.chart_samples;
+
+    k_msleep(10 * INTERVAL_MS);
+    zassert_equal(widget.chart_samples, samples, "sampling an empty chart");
+}
+
+ZTEST_SUITE(wpm_status, NULL, setup, before, NULL, NULL);